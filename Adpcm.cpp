@@ -0,0 +1,27 @@
+// Adpcm.cpp
+// Runs on MSPM0G3507, and on the PC in tools/adpcm
+// IMA-ADPCM decoding, see Adpcm.h
+
+#include <stdint.h>
+#include "Adpcm.h"
+
+// The IMA step sizes, each about 10% bigger than the last
+const int16_t Adpcm_Steps[ADPCM_STEPS] = {
+  7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+  50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230,
+  253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963,
+  1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327,
+  3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487,
+  12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+};
+
+// How the step index moves after each size of code
+const int8_t Adpcm_Indexes[8] = {-1, -1, -1, -1, 2, 4, 6, 8};
+
+int32_t Adpcm_Start(Adpcm *s, const AdpcmAsset *asset){
+    s->data = asset->data;
+    s->nibble = 0;
+    s->predictor = asset->predictor;
+    s->index = asset->index;
+    return asset->predictor>>8;
+}
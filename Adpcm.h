@@ -0,0 +1,80 @@
+// Adpcm.h
+// Runs on MSPM0G3507, and on the PC in tools/adpcm
+// 4-bit IMA-ADPCM sound assets, two samples a byte, low nibble first.
+// Each nibble is a step up or down from the last sample, scaled by a
+// step size that grows after big steps and shrinks after small ones,
+// so an 8-bit sound takes half the flash. The predictor is 16-bit as
+// IMA specifies; samples come out as signed 8-bit.
+//
+// tools/adpcm encodes every array in sounds/sounds.h into
+// sounds/adpcm.h. Decoding a sample is about 55 cycles on the M0+.
+
+#ifndef ADPCM_H_
+#define ADPCM_H_
+#include <stdint.h>
+
+// One encoded sound, the first sample is in the header
+struct AdpcmAsset {
+    const uint8_t *data;    // samples-1 nibbles
+    uint32_t samples;
+    int16_t predictor;      // first sample, 16-bit
+    uint8_t index;          // into Adpcm_Steps for the second
+};
+
+// Where a decode is up to
+struct Adpcm {
+    const uint8_t *data;
+    uint32_t nibble;        // next nibble, from the start of data
+    int32_t predictor;      // last sample, 16-bit
+    int32_t index;
+};
+
+#define ADPCM_STEPS 89
+extern const int16_t Adpcm_Steps[ADPCM_STEPS];
+extern const int8_t Adpcm_Indexes[8];
+
+// Applies one 4-bit code: bit 3 the sign, bits 2-0 the size in steps/4
+// Returns the new predictor, 16-bit; the encoder runs the same code so
+// both stay in step
+inline int32_t Adpcm_Apply(Adpcm *s, uint32_t code){
+    int32_t step = Adpcm_Steps[s->index];
+    int32_t diff = step>>3;
+    if(code & 4){
+        diff += step;
+    }
+    if(code & 2){
+        diff += step>>1;
+    }
+    if(code & 1){
+        diff += step>>2;
+    }
+    int32_t predictor = (code & 8) ? s->predictor - diff : s->predictor + diff;
+    if(predictor > 32767){
+        predictor = 32767;
+    }
+    else if(predictor < -32768){
+        predictor = -32768;
+    }
+    s->predictor = predictor;
+    int32_t index = s->index + Adpcm_Indexes[code & 7];
+    if(index < 0){
+        index = 0;
+    }
+    else if(index > ADPCM_STEPS-1){
+        index = ADPCM_STEPS-1;
+    }
+    s->index = index;
+    return predictor;
+}
+
+// Starts a decode, returns the first sample
+int32_t Adpcm_Start(Adpcm *s, const AdpcmAsset *asset);
+
+// Next sample, signed 8-bit; call samples-1 times after Adpcm_Start
+inline int32_t Adpcm_Next(Adpcm *s){
+    uint32_t n = s->nibble++;
+    uint32_t code = (s->data[n>>1] >> ((n & 1)<<2)) & 0x0F;
+    return Adpcm_Apply(s, code)>>8;
+}
+
+#endif /* ADPCM_H_ */
@@ -0,0 +1,73 @@
+/*
+ * Chart.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author:
+ */
+
+#include <stdint.h>
+#include "Chart.h"
+
+ChartReader::ChartReader(){
+    chart = 0;
+    pos = 0;
+    note = 0;
+    blank = 0;
+    pitch = CHART_FIRST_PITCH;
+}
+
+void ChartReader::start(const Chart *chart){
+    this->chart = chart;
+    pos = 0;
+    note = 0;
+    blank = chart->leadIn;
+    pitch = CHART_FIRST_PITCH;
+}
+
+// Next n bits of the stream, n is at most 8 so two bytes always cover it
+uint8_t ChartReader::bits(uint8_t n){
+    const uint8_t *p = &chart->stream[pos >> 3];
+    uint32_t word = p[0] | (p[1] << 8);
+    uint8_t value = (word >> (pos & 7)) & ((1 << n) - 1);
+    pos += n;
+    return value;
+}
+
+// A note is one row with its keys, duration rows tall, then rest empty rows.
+// Decodes one packed note, see Chart.h for the layout
+bool ChartReader::next(ChartRow *row){
+    if(blank){
+        blank--;
+        row->lanes = 0;
+        row->pitch = 0;
+        row->length = 1;
+        return true;
+    }
+    if(note >= chart->noteCount)
+        return false;
+    note++;
+    row->lanes = bits(4);
+
+    uint8_t code = bits(4);
+    if(code == 15){
+        row->pitch = bits(7);
+    }
+    else{
+        row->pitch = pitch + code - 7;
+    }
+    if(row->pitch != 0){
+        pitch = row->pitch;
+    }
+
+    uint8_t duration = bits(2) + 1;
+    if(duration == 4){
+        duration = bits(8);
+    }
+    uint8_t rest = bits(2);
+    if(rest == 3){
+        rest = bits(8);
+    }
+    row->length = duration;
+    blank = rest;
+    return true;
+}
@@ -0,0 +1,225 @@
+/*
+ * Chart.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author:
+ *
+ *  Song charts. A chart is written as a list of notes; each note says which
+ *  keys to press, which pitch to play, how many rows it lasts and how many
+ *  empty rows follow it. A note longer than one row is a hold note, one
+ *  tall row whose keys have to stay down until its tail passes.
+ *  CHART_PACK() checks the notes and packs them into a bitstream at
+ *  compile time, only the bitstream goes into flash. ChartReader decodes
+ *  it into screen rows one at a time as they scroll on, in constant time
+ *  per row.
+ *
+ *  A rest is at most 255 rows. A longer one is split with spacers, notes
+ *  with no keys and pitch 0 that are one empty row each and carry the rest
+ *  of the rest; they aren't judged and don't count as notes.
+ *
+ *  Adding a song is one ChartNote array, its CHART_PACK() and one CHART()
+ *  entry in Charts[]. A bad chart is a build error rather than a wrong
+ *  song on the board.
+ *
+ *  Packed note, fields LSB first:
+ *    lanes     4 bits
+ *    pitch     4 bits, change from the last pitch + 7 (-7..+7),
+ *              15 is an escape followed by the 7-bit pitch
+ *    duration  2 bits, 1..3 rows as 0..2, 3 is an escape followed by 8 bits
+ *    rest      2 bits, 0..2 rows, 3 is an escape followed by 8 bits
+ *  A stepwise melody note with no long rest is 12 bits.
+ */
+
+#ifndef CHART_H_
+#define CHART_H_
+#include <stdint.h>
+
+struct ChartNote {
+    uint8_t pitch;      // MIDI note number, 60 is C4, 0 for silence
+    uint8_t lanes;      // keys to press, bit 3 is Key1 ... bit 0 is Key4, 0 for a spacer
+    uint8_t duration;   // rows the note lasts, at least 1
+    uint8_t rest;       // empty rows after the note
+};
+
+struct ChartRow {
+    uint8_t lanes;      // 0 for an empty row
+    uint8_t pitch;      // 0 for an empty row
+    uint8_t length;     // rows tall, a note longer than 1 is a hold
+};
+
+struct Chart {
+    const uint8_t *stream;              // packed notes
+    uint16_t noteCount;                 // spacers included, the stream's length
+    uint16_t keyNotes;                  // notes with keys, the ones that are judged
+    uint16_t rows;                      // rows ChartReader returns, lead-in and rests included
+    uint8_t leadIn;                     // empty rows before the first note
+    const unsigned short *title[2];     // 40x20 menu sprite, English and Spanish
+};
+
+extern const Chart Charts[];
+extern const uint8_t ChartCount;
+
+// Pitches Sound_Note plays cleanly with the 32-sample wave at SOUND_RATE
+#define CHART_PITCH_LOW  48     // C3
+#define CHART_PITCH_HIGH 84     // C6
+
+// Compile-time checks used by CHART(), they walk the note array in a constant expression
+
+// A note with no keys has to be a spacer, silent and one row
+template<uint16_t N>
+constexpr bool Chart_LanesValid(const ChartNote (&notes)[N]){
+    for(uint16_t i = 0; i < N; i++){
+        if(notes[i].lanes > 0x0F)
+            return false;
+        if(notes[i].lanes == 0 && (notes[i].pitch != 0 || notes[i].duration != 1))
+            return false;
+    }
+    return true;
+}
+
+template<uint16_t N>
+constexpr bool Chart_PitchesValid(const ChartNote (&notes)[N]){
+    for(uint16_t i = 0; i < N; i++){
+        if(notes[i].pitch != 0 && (notes[i].pitch < CHART_PITCH_LOW || notes[i].pitch > CHART_PITCH_HIGH))
+            return false;
+    }
+    return true;
+}
+
+template<uint16_t N>
+constexpr bool Chart_DurationsValid(const ChartNote (&notes)[N]){
+    for(uint16_t i = 0; i < N; i++){
+        if(notes[i].duration == 0)
+            return false;
+    }
+    return true;
+}
+
+// A note is one row however long it is, rests are one row each.
+// tools/midi2chart reports the same count from its own notes.
+constexpr uint32_t Chart_CountRows(const ChartNote *notes, uint16_t count, uint8_t leadIn){
+    uint32_t rows = leadIn;
+    for(uint16_t i = 0; i < count; i++){
+        rows += 1 + notes[i].rest;
+    }
+    return rows;
+}
+
+template<uint16_t N>
+constexpr uint32_t Chart_CountRows(const ChartNote (&notes)[N], uint8_t leadIn){
+    return Chart_CountRows(notes, N, leadIn);
+}
+
+// Spacers left out
+template<uint16_t N>
+constexpr uint16_t Chart_CountKeyNotes(const ChartNote (&notes)[N]){
+    uint16_t keyNotes = 0;
+    for(uint16_t i = 0; i < N; i++){
+        keyNotes += (notes[i].lanes != 0);
+    }
+    return keyNotes;
+}
+
+#define CHART_FIRST_PITCH 60    // pitch deltas start from C4
+
+// Writes n bits of value LSB first at bit pos, out can be 0 to only count
+constexpr uint32_t Chart_PutBits(uint8_t *out, uint32_t pos, uint32_t value, uint8_t n){
+    for(uint8_t i = 0; i < n; i++){
+        if(out && ((value >> i) & 1)){
+            out[(pos + i) >> 3] |= (uint8_t)(1 << ((pos + i) & 7));
+        }
+    }
+    return pos + n;
+}
+
+// Packs notes into out, returns the length in bits; out can be 0 to only size it
+constexpr uint32_t Chart_Encode(const ChartNote *notes, uint16_t count, uint8_t *out){
+    uint32_t pos = 0;
+    int16_t last = CHART_FIRST_PITCH;
+    for(uint16_t i = 0; i < count; i++){
+        const ChartNote &n = notes[i];
+        pos = Chart_PutBits(out, pos, n.lanes, 4);
+
+        int16_t delta = (int16_t)n.pitch - last;
+        if(n.pitch != 0 && delta >= -7 && delta <= 7){
+            pos = Chart_PutBits(out, pos, delta + 7, 4);
+        }
+        else{
+            pos = Chart_PutBits(out, pos, 15, 4);
+            pos = Chart_PutBits(out, pos, n.pitch, 7);
+        }
+        if(n.pitch != 0){
+            last = n.pitch;
+        }
+
+        if(n.duration <= 3){
+            pos = Chart_PutBits(out, pos, n.duration - 1, 2);
+        }
+        else{
+            pos = Chart_PutBits(out, pos, 3, 2);
+            pos = Chart_PutBits(out, pos, n.duration, 8);
+        }
+
+        if(n.rest < 3){
+            pos = Chart_PutBits(out, pos, n.rest, 2);
+        }
+        else{
+            pos = Chart_PutBits(out, pos, 3, 2);
+            pos = Chart_PutBits(out, pos, n.rest, 8);
+        }
+    }
+    return pos;
+}
+
+// Packed size in bytes, one zero byte of padding lets the decoder read two bytes at a time
+constexpr uint32_t Chart_PackedBytes(const ChartNote *notes, uint16_t count){
+    return (Chart_Encode(notes, count, 0) + 7)/8 + 1;
+}
+
+template<uint32_t BYTES>
+struct ChartStream {
+    uint8_t bytes[BYTES];
+};
+
+template<uint32_t BYTES>
+constexpr ChartStream<BYTES> Chart_Pack(const ChartNote *notes, uint16_t count){
+    ChartStream<BYTES> stream = {};
+    Chart_Encode(notes, count, stream.bytes);
+    return stream;
+}
+
+#define CHART_NOTES(notes) ((uint16_t)(sizeof(notes)/sizeof(ChartNote)))
+
+// Checks a constexpr ChartNote array and packs it into notes##Stream
+#define CHART_PACK(notes, leadIn) \
+    static_assert(sizeof(notes)/sizeof(ChartNote) > 0 && sizeof(notes)/sizeof(ChartNote) <= 0xFFFF, #notes " note count out of range"); \
+    static_assert(Chart_LanesValid(notes), #notes " has a lane above Key1, or a note with no keys that isn't a spacer"); \
+    static_assert(Chart_PitchesValid(notes), #notes " has a pitch outside CHART_PITCH_LOW..CHART_PITCH_HIGH"); \
+    static_assert(Chart_DurationsValid(notes), #notes " has a note with zero duration"); \
+    static_assert(Chart_CountRows(notes, leadIn) <= 0xFFFF, #notes " has too many rows"); \
+    constexpr ChartStream<Chart_PackedBytes(notes, CHART_NOTES(notes))> notes##Stream = \
+        Chart_Pack<Chart_PackedBytes(notes, CHART_NOTES(notes))>(notes, CHART_NOTES(notes))
+
+// One Charts[] entry, the row count is worked out by the compiler
+#define CHART(notes, leadIn, english, spanish) \
+    {notes##Stream.bytes, CHART_NOTES(notes), Chart_CountKeyNotes(notes), (uint16_t)Chart_CountRows(notes, leadIn), leadIn, {english, spanish}}
+
+class ChartReader
+{
+public:
+    ChartReader();
+
+    void start(const Chart *chart);
+    bool next(ChartRow *row);   // false once the chart is finished
+
+private:
+    uint8_t bits(uint8_t n);
+
+    const Chart *chart;
+    uint32_t pos;       // bit position in the stream
+    uint16_t note;      // index of the next note
+    uint16_t blank;     // empty rows to emit before it
+    uint8_t pitch;      // last pitch decoded, deltas are from it
+};
+
+#endif /* CHART_H_ */
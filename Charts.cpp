@@ -0,0 +1,49 @@
+/*
+ * Charts.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author:
+ *
+ *  The song table shown by the menu, in order. The note arrays are
+ *  constexpr so CHART_PACK can check and pack them at compile time.
+ */
+
+#include <stdint.h>
+#include "Chart.h"
+#include "Sprite.h"
+
+#define C4 60
+#define D4 62
+#define E4 64
+#define F4 65
+#define G4 67
+#define A4 69
+#define Bflat4 70
+#define C5 72
+
+// Twinkle Twinkle
+constexpr ChartNote Twinkle[] = {
+    {C4, 8, 1, 0}, {C4, 8, 1, 0}, {G4, 2, 1, 0}, {G4, 2, 1, 0}, {A4, 1, 1, 0}, {A4, 1, 1, 0}, {G4, 10, 1, 1},
+    {F4, 1, 1, 0}, {F4, 1, 1, 0}, {E4, 2, 1, 0}, {E4, 2, 1, 0}, {D4, 4, 1, 0}, {D4, 4, 1, 0}, {C4, 10, 1, 1},
+    {G4, 2, 1, 0}, {G4, 2, 1, 0}, {F4, 4, 1, 0}, {F4, 4, 1, 0}, {E4, 8, 1, 0}, {E4, 8, 1, 0}, {D4, 5, 1, 1},
+    {G4, 2, 1, 0}, {G4, 2, 1, 0}, {F4, 4, 1, 0}, {F4, 4, 1, 0}, {E4, 8, 1, 0}, {E4, 8, 1, 0}, {D4, 5, 1, 1},
+    {C4, 8, 1, 0}, {C4, 8, 1, 0}, {G4, 2, 1, 0}, {G4, 2, 1, 0}, {A4, 1, 1, 0}, {A4, 1, 1, 0}, {G4, 10, 1, 1},
+    {F4, 1, 1, 0}, {F4, 1, 1, 0}, {E4, 2, 1, 0}, {E4, 2, 1, 0}, {D4, 4, 1, 0}, {D4, 4, 1, 0}, {C4, 15, 1, 1},
+};
+CHART_PACK(Twinkle, 3);
+
+// Happy Birthday
+constexpr ChartNote Birthday[] = {
+    {C4, 8, 1, 0}, {C4, 8, 1, 0}, {D4, 4, 1, 0}, {C4, 8, 1, 0}, {F4, 2, 1, 0}, {E4, 10, 1, 1},
+    {C4, 8, 1, 0}, {C4, 8, 1, 0}, {D4, 4, 1, 0}, {C4, 8, 1, 0}, {G4, 1, 1, 0}, {F4, 5, 1, 1},
+    {C4, 8, 1, 0}, {C4, 8, 1, 0}, {C5, 1, 1, 0}, {A4, 2, 1, 0}, {F4, 4, 1, 0}, {E4, 8, 1, 0}, {D4, 9, 1, 1},
+    {Bflat4, 1, 1, 0}, {Bflat4, 1, 1, 0}, {A4, 2, 1, 0}, {F4, 8, 1, 0}, {G4, 4, 1, 0}, {F4, 11, 1, 1},
+};
+CHART_PACK(Birthday, 3);
+
+const Chart Charts[] = {
+    CHART(Twinkle, 3, Sprite::Song1English, Sprite::Song1Spanish),
+    CHART(Birthday, 3, Sprite::Song2English, Sprite::Song2Spanish),
+};
+
+const uint8_t ChartCount = sizeof(Charts)/sizeof(Chart);
@@ -0,0 +1,53 @@
+/*
+ * Debounce.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author:
+ *
+ *  Bit-parallel (vertical counter) debouncer. Every bit of the input word
+ *  is an independent lane with its own 2-bit counter, stored as bit n of
+ *  ct0 and ct1, so all lanes are debounced by the same few logic ops.
+ *  A lane changes state after 4 consecutive samples disagree with it;
+ *  sampled at 1kHz that is 4ms, longer than a typical switch bounce.
+ *  Up to 32 lanes, no extra code per lane.
+ */
+
+#ifndef DEBOUNCE_H_
+#define DEBOUNCE_H_
+#include <stdint.h>
+
+class Debounce
+{
+public:
+    Debounce(){
+        state = 0;
+        ct0 = ~0u;
+        ct1 = ~0u;
+        down = 0;
+        up = 0;
+    }
+
+    // call at a fixed rate with one bit per lane, 1 is pressed
+    void sample(uint32_t in){
+        uint32_t delta = state ^ in;    // lanes that disagree with the debounced state
+        ct0 = ~(ct0 & delta);           // counters of agreeing lanes reset to 3
+        ct1 = ct0 ^ (ct1 & delta);      // others count down 3,2,1,0
+        delta &= ct0 & ct1;             // lanes whose counter rolled over
+        state ^= delta;
+        down = state & delta;
+        up = ~state & delta;
+    }
+
+    uint32_t pressed(){ return down; }   // lanes that went down on the last sample
+    uint32_t released(){ return up; }    // lanes that went up on the last sample
+    uint32_t held(){ return state; }     // debounced state of every lane
+
+private:
+    uint32_t state;
+    uint32_t ct0;
+    uint32_t ct1;
+    uint32_t down;
+    uint32_t up;
+};
+
+#endif /* DEBOUNCE_H_ */
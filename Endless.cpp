@@ -0,0 +1,88 @@
+/*
+ * Endless.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author:
+ */
+
+#include <stdint.h>
+#include "Endless.h"
+
+// C major from C4 to C5, MIDI numbers
+#define SCALE_SIZE 8
+const uint8_t Scale[SCALE_SIZE] = {60, 62, 64, 65, 67, 69, 71, 72};
+
+const uint8_t Speeds[ENDLESS_SPEED_COUNT] = ENDLESS_SPEEDS;
+
+Endless::Endless(){
+    start(1);
+}
+
+void Endless::start(uint32_t seed){
+    this->seed = seed;
+    rows = 0;
+    degree = 0;
+    lane = 0;
+}
+
+// Same LCG as Random32, own state so a run only depends on its seed
+uint32_t Endless::random(uint32_t n){
+    seed = 1664525*seed + 1013904223;
+    return (seed>>16)%n;
+}
+
+uint16_t Endless::getLevel(){
+    uint32_t level = rows/ENDLESS_LEVEL_ROWS;
+    return level > 0xFFFF ? 0xFFFF : level;
+}
+
+uint8_t Endless::getScroll(){
+    uint32_t step = getLevel()/ENDLESS_SPEED_LEVELS;
+    if(step >= ENDLESS_SPEED_COUNT){
+        step = ENDLESS_SPEED_COUNT - 1;
+    }
+    return Speeds[step];
+}
+
+void Endless::next(ChartRow *row){
+    uint16_t level = getLevel();
+    rows++;
+    row->length = 1;
+
+    uint32_t density = ENDLESS_DENSITY_START + level*ENDLESS_DENSITY_STEP;
+    if(density > ENDLESS_DENSITY_MAX){
+        density = ENDLESS_DENSITY_MAX;
+    }
+    if(random(16) >= density){
+        row->lanes = 0;
+        row->pitch = 0;
+        return;
+    }
+
+    // the melody steps up to two scale degrees, the lane follows it
+    int8_t step = (int8_t)random(5) - 2;
+    if((step < 0 && degree < (uint8_t)-step) || degree + step >= SCALE_SIZE){
+        step = -step;
+    }
+    degree += step;
+    lane += step > 0 ? 1 : (step < 0 ? -1 : 0);
+    if(lane > 3){
+        lane = 2;
+    }
+    if(lane < 0){
+        lane = 1;
+    }
+    row->pitch = Scale[degree];
+    row->lanes = 1 << (3 - lane);
+
+    uint32_t chord = 0;
+    if(level >= ENDLESS_CHORD_LEVEL){
+        chord = (level - ENDLESS_CHORD_LEVEL + 1)*ENDLESS_CHORD_STEP;
+        if(chord > ENDLESS_CHORD_MAX){
+            chord = ENDLESS_CHORD_MAX;
+        }
+    }
+    if(random(16) < chord){
+        row->lanes |= 1 << (3 - (lane < 2 ? lane + 2 : lane - 2));
+    }
+}
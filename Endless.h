@@ -0,0 +1,57 @@
+/*
+ * Endless.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author:
+ *
+ *  Endless mode. Rows are made up one at a time as they scroll on, from a
+ *  seeded generator, so the same seed always gives the same run and the
+ *  state is a few words no matter how long the run lasts.
+ *
+ *  Difficulty goes up a level every ENDLESS_LEVEL_ROWS rows: more rows
+ *  have notes, chords start to appear, and the scroll speeds up.
+ */
+
+#ifndef ENDLESS_H_
+#define ENDLESS_H_
+#include <stdint.h>
+#include "Chart.h"
+
+#define ENDLESS_LEVEL_ROWS    32  // rows per difficulty level
+
+// Chance that a row has a note, in 16ths
+#define ENDLESS_DENSITY_START  8
+#define ENDLESS_DENSITY_STEP   1  // per level
+#define ENDLESS_DENSITY_MAX   15
+
+// Chance that a note is a two-key chord, in 16ths
+#define ENDLESS_CHORD_LEVEL    2  // first level with chords
+#define ENDLESS_CHORD_STEP     1  // per level after that
+#define ENDLESS_CHORD_MAX      6
+
+// Scroll speed in pixels per frame, must divide the 30 pixel row pitch
+#define ENDLESS_SPEED_LEVELS   4  // levels between speed ups
+#define ENDLESS_SPEED_COUNT    3
+#define ENDLESS_SPEEDS         {2, 3, 5}
+
+class Endless
+{
+public:
+    Endless();
+
+    void start(uint32_t seed);
+    void next(ChartRow *row);   // never runs out
+
+    uint16_t getLevel();
+    uint8_t getScroll();        // pixels per frame for the current level
+
+private:
+    uint32_t random(uint32_t n);
+
+    uint32_t seed;
+    uint32_t rows;      // rows generated so far
+    uint8_t degree;     // index into the scale, the melody walks along it
+    int8_t lane;        // lane of the last note, 0 is Key1
+};
+
+#endif /* ENDLESS_H_ */
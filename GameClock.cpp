@@ -0,0 +1,44 @@
+// GameClock.cpp
+// Runs on MSPM0G3507
+// 32-bit game timebase on the TIMG12 game engine timer, see GameClock.h.
+// TIMG12 counts down from GAMECLOCK_FRAME-1 to 0, so the time within a
+// frame is (GAMECLOCK_FRAME-1)-CTR; the frame count supplies the upper bits.
+
+#include <stdint.h>
+#include <ti/devices/msp/msp.h>
+#include "../inc/Timer.h"
+#include "GameClock.h"
+
+static volatile uint32_t Frames;
+
+// Time 0 is TIMG12 starting to count, however long the boot took before it
+void GameClock_Init(uint32_t priority){
+  Frames = 0;
+  TimerG12_IntArm(GAMECLOCK_FRAME, priority);
+}
+
+void GameClock_Tick(void){
+  Frames++;
+}
+
+uint32_t GameClock_Now(void){uint32_t frames,ctr;
+  do{
+    frames = Frames;
+    ctr = TIMG12->COUNTERREGS.CTR;
+  }while(frames != Frames); // TIMG12 ISR ran in between, read again
+  // Masked, or in an ISR at TIMG12's priority or above, the counter can
+  // have reloaded before TIMG12_IRQHandler counted the frame; the pending
+  // zero event counts
+  if((TIMG12->CPU_INT.RIS&0x01) && (ctr > GAMECLOCK_FRAME/2)){
+    frames++;
+  }
+  return frames*GAMECLOCK_FRAME + (GAMECLOCK_FRAME-1-ctr);
+}
+
+uint32_t GameClock_FrameStart(void){
+  return Frames*GAMECLOCK_FRAME;
+}
+
+uint32_t GameClock_Frames(void){
+  return Frames;
+}
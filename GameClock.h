@@ -0,0 +1,40 @@
+// GameClock.h
+// Runs on MSPM0G3507
+// 32-bit game timebase on TIMG12, the 30Hz game engine timer. It runs
+// from GameClock_Init and never stops, so the time is the frames counted
+// times GAMECLOCK_FRAME plus how far TIMG12 has counted into the next
+// one. How long the boot takes before GameClock_Init doesn't move any
+// time after it, so a Recorder capture replays the same on another build.
+// Scrolling, hit times, key presses and the notes they play are all on
+// this one clock, so they can't drift apart; the sound's SysTick is free
+// to stop when nothing plays, see Sound.h.
+// Time is counted in bus cycles (12.5ns at 80MHz) and wraps every ~53s,
+// so always compare two times by subtraction, (int32_t)(a-b).
+// Each frame starts on a TIMG12 event, at a whole GAMECLOCK_FRAME.
+
+#ifndef GAMECLOCK_H_
+#define GAMECLOCK_H_
+#include <stdint.h>
+
+#define GAMECLOCK_HZ     80000000            // bus clock, timer counts per second
+#define GAMECLOCK_FRAME  (GAMECLOCK_HZ/30)   // TIMG12 period, one game frame
+#define GAMECLOCK_MS(ms) ((uint32_t)(ms)*(GAMECLOCK_HZ/1000))
+
+// Makes this time 0, arms TIMG12 for the 30Hz game engine interrupt and
+// clears the frame count
+// priority is 0(highest),1,2 or 3(lowest)
+void GameClock_Init(uint32_t priority);
+
+// Must be the first thing TIMG12_IRQHandler does after acknowledging
+void GameClock_Tick(void);
+
+// Current time in bus cycles, safe to call from any priority
+uint32_t GameClock_Now(void);
+
+// Time of the TIMG12 event that started the current frame
+uint32_t GameClock_FrameStart(void);
+
+// Number of game frames since GameClock_Init
+uint32_t GameClock_Frames(void);
+
+#endif /* GAMECLOCK_H_ */
@@ -0,0 +1,138 @@
+/*
+ * Judge.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author:
+ */
+
+#include <stdint.h>
+#include "Judge.h"
+
+Judge::Judge(uint32_t perfectMs, uint32_t greatMs, uint32_t goodMs)
+{
+    setWindows(perfectMs, greatMs, goodMs);
+    reset();
+}
+
+void Judge::setWindows(uint32_t perfectMs, uint32_t greatMs, uint32_t goodMs){
+    perfect = GAMECLOCK_MS(perfectMs);
+    great = GAMECLOCK_MS(greatMs);
+    good = GAMECLOCK_MS(goodMs);
+}
+
+void Judge::reset(){
+    for(uint8_t i = 0; i < JUDGE_LANES; i++){
+        getI[i] = putI[i];
+    }
+    for(uint8_t i = 0; i < 4; i++){
+        counts[i] = 0;
+    }
+}
+
+// A press into a full lane is dropped, the lane is 8 presses behind so it is stale anyway.
+void Judge::press(uint8_t lane, uint32_t time){
+    uint8_t put = putI[lane];
+    if(((put + 1) & (JUDGE_PRESSES - 1)) == getI[lane])
+        return;
+    pressTime[lane][put] = time;
+    putI[lane] = (put + 1) & (JUDGE_PRESSES - 1);
+}
+
+bool Judge::peek(uint8_t lane, uint32_t *time){
+    if(getI[lane] == putI[lane])
+        return false;
+    *time = pressTime[lane][getI[lane]];
+    return true;
+}
+
+void Judge::drop(uint8_t lane){
+    getI[lane] = (getI[lane] + 1) & (JUDGE_PRESSES - 1);
+}
+
+Grade Judge::grade(uint32_t error){
+    if(error <= perfect)
+        return Perfect;
+    if(error <= great)
+        return Great;
+    if(error <= good)
+        return Good;
+    return Miss;
+}
+
+// Used every frame for immediate feedback (gray keys, note sound), does not consume
+bool Judge::isHit(uint8_t lanes, uint32_t hitTime){
+    for(uint8_t i = 0; i < JUDGE_LANES; i++){
+        if((lanes & (1 << i)) == 0)
+            continue;
+        uint32_t time;
+        if(!peek(i, &time))
+            return false;
+        int32_t error = (int32_t)(time - hitTime);
+        if(error < -(int32_t)good || error > (int32_t)good)
+            return false;
+    }
+    return lanes != 0;
+}
+
+// Called once the row is past its window (hitTime + good is in the past).
+// Per lane: presses before the window are stray, the first press inside
+// the window on a lane the row wants is graded, later presses are kept.
+// Any other press inside the window, a wrong key or a second tap, is kept
+// if it is inside the next row's window on a lane that row wants: when the
+// scroll is fast the next row is due inside this row's window, it is that
+// row's press. Otherwise it is stray here, it isn't left to make the next
+// row a Miss.
+// The row gets the worst grade of its lanes, any stray press makes it a Miss.
+Grade Judge::judgeRow(uint8_t lanes, uint32_t hitTime, uint8_t nextLanes, uint32_t nextHitTime){
+    Grade result = Perfect;
+    uint32_t time;
+
+    for(uint8_t i = 0; i < JUDGE_LANES; i++){
+        bool wanted = lanes & (1 << i);
+        Grade laneGrade = wanted ? Miss : Perfect;
+
+        while(peek(i, &time)){
+            int32_t error = (int32_t)(time - hitTime);
+            if(error > (int32_t)good)
+                break;                      // early press for a later row
+            if(error >= -(int32_t)good && wanted){
+                drop(i);
+                laneGrade = grade(error < 0 ? -error : error);
+                wanted = false;             // one press per lane per row
+                continue;
+            }
+            int32_t nextError = (int32_t)(time - nextHitTime);
+            if(error >= -(int32_t)good && (nextLanes & (1 << i))
+               && nextError >= -(int32_t)good && nextError <= (int32_t)good)
+                break;                      // the next row's
+            drop(i);
+            result = Miss;                  // stray
+        }
+        if(laneGrade < result)
+            result = laneGrade;
+    }
+
+    counts[result]++;
+    return result;
+}
+
+// Moves one row's count, the game decides a hold's grade after its head
+void Judge::regrade(Grade from, Grade to){
+    if(counts[from]){
+        counts[from]--;
+        counts[to]++;
+    }
+}
+
+uint32_t Judge::getCount(Grade grade){
+    return counts[grade];
+}
+
+uint32_t Judge::points(Grade grade){
+    switch(grade){
+    case Perfect: return 100;
+    case Great:   return 75;
+    case Good:    return 50;
+    default:      return 0;
+    }
+}
@@ -0,0 +1,69 @@
+/*
+ * Judge.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author:
+ *
+ *  Timing-window hit judgement. Key presses are timestamped with
+ *  GameClock_Now() by the input ISR and handed to press() from the game
+ *  ISR, which buffers them per lane.
+ *  When a row is judged its ideal hit time is compared with the oldest
+ *  buffered press on each lane and graded Perfect/Great/Good/Miss.
+ *  Presses that are too late for the row being judged stay in the buffer,
+ *  they are early presses for the rows that follow. Any other press in its
+ *  window, a wrong key or a second tap, stays only if the next row that
+ *  wants keys wants that lane and the press is in that row's window too,
+ *  else the row being judged is a Miss for it.
+ */
+
+#ifndef JUDGE_H_
+#define JUDGE_H_
+#include <stdint.h>
+#include "GameClock.h"
+
+// default half-widths of the windows around the ideal hit time
+#define JUDGE_PERFECT_MS  50
+#define JUDGE_GREAT_MS   100
+#define JUDGE_GOOD_MS    200
+
+#define JUDGE_LANES   4   // lane n is bit n of a row's lane mask
+#define JUDGE_PRESSES 8   // buffered presses per lane, power of 2
+
+enum Grade {Miss, Good, Great, Perfect};
+
+class Judge
+{
+public:
+    Judge(uint32_t perfectMs, uint32_t greatMs, uint32_t goodMs);
+
+    void setWindows(uint32_t perfectMs, uint32_t greatMs, uint32_t goodMs);
+    void reset();                               // forget presses and grade counts
+
+    void press(uint8_t lane, uint32_t time);    // buffer a timestamped press
+    bool isHit(uint8_t lanes, uint32_t hitTime);  // every lane pressed in its window yet?
+    // consume presses, grade the row; next is the next row that wants keys,
+    // nextLanes 0 when there isn't one
+    Grade judgeRow(uint8_t lanes, uint32_t hitTime, uint8_t nextLanes, uint32_t nextHitTime);
+    void regrade(Grade from, Grade to);         // a judged row turned out otherwise, e.g. a hold let go
+
+    uint32_t getCount(Grade grade);
+    static uint32_t points(Grade grade);        // score for a grade, 100 max per row
+
+private:
+    Grade grade(uint32_t error);
+    bool peek(uint8_t lane, uint32_t *time);
+    void drop(uint8_t lane);
+
+    uint32_t perfect;   // windows in GameClock counts
+    uint32_t great;
+    uint32_t good;
+
+    // one small FIFO per lane of presses not yet matched to a row
+    uint32_t pressTime[JUDGE_LANES][JUDGE_PRESSES];
+    uint8_t putI[JUDGE_LANES];
+    uint8_t getI[JUDGE_LANES];
+
+    uint32_t counts[4];
+};
+
+#endif /* JUDGE_H_ */
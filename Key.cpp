@@ -296,10 +296,42 @@ void Key::initializeKey(int16_t x, int16_t y, uint16_t width, uint16_t height, c
     this-> width = width;
     this->height = height;
     this->keyArray = keyArray;
+    this->needsDraw = false;
+}
+
+// Fills screen rows top to bottom-1 of column x..x+w-1, clipped to the playfield
+static void fillClipped(int16_t x, int16_t top, int16_t w, int16_t bottom, uint16_t color){
+    if(top < KEY_TOP)
+        top = KEY_TOP;
+    if(bottom > KEY_BOTTOM)
+        bottom = KEY_BOTTOM;
+    if(top < bottom)
+        ST7735_FillRect(x, top, w, bottom - top, color);
+}
+
+// Draws rows top to bottom-1 of a hold key the same way the bitmaps look:
+// black edge columns, a black line under a white key, solid black for black
+void Key::drawFill(int16_t top, int16_t bottom){
+    if(keyArray == black_key){
+        fillClipped(x, top, width, bottom, 0x0000);
+        return;
+    }
+    uint16_t color = (keyArray == gray_key) ? 0xB596 : 0xFFFF;
+    fillClipped(x, top, 1, bottom, 0x0000);
+    fillClipped(x + 1, top, width - 2, bottom, color);
+    fillClipped(x + width - 1, top, 1, bottom, 0x0000);
+    if(keyArray == white_key && bottom == y + height){
+        fillClipped(x, bottom - 1, width, bottom, 0x0000);
+    }
 }
 
 void Key::drawKey(){
     oldY = y;
+    if(height > KEY_BITMAP_HEIGHT){
+        needsDraw = false;
+        drawFill(y, y + height);
+        return;
+    }
 
     if(y + height > 140){
         ST7735_DrawBitmap(x, 140, keyArray, width, 140-y);
@@ -316,6 +348,22 @@ void Key::drawKey(){
 
 void Key::redrawKey(){
 
+    // hold keys only draw the strips that changed, or all of it after a color change
+    if(height > KEY_BITMAP_HEIGHT){
+        if(needsDraw){
+            drawKey();
+        }
+        else if(oldY < y){
+            fillClipped(x, oldY, width, y, 0xFFFF);
+            drawFill(oldY + height - 1, y + height);
+            oldY = y;
+        }
+        else if(oldY > y){
+            fillClipped(x, y + height, width, oldY + height, 0xFFFF);
+            drawKey();
+        }
+        return;
+    }
 
     if(oldY == y)
         return;
@@ -360,6 +408,10 @@ void Key::moveKey(int16_t y){
 }
 
 void Key::clearKey(){
+    if(height > KEY_BITMAP_HEIGHT){
+        fillClipped(x, y, width, y + height, 0xFFFF);
+        return;
+    }
     ST7735_DrawBitmap(x, y + height, blank_white, width, height);
 }
 
@@ -379,10 +431,12 @@ const unsigned short* Key::getArray(){
 
 void Key::switchToClicked(){
     keyArray = gray_key;
+    needsDraw = true;
 }
 
 void Key::switchToUnclicked(){
     keyArray = black_key;
+    needsDraw = true;
 }
 
 Key::~Key()
@@ -12,6 +12,10 @@
 #include <stdint.h>
 #include <ti/devices/msp/msp.h>
 
+#define KEY_BITMAP_HEIGHT 30    // taller keys are hold notes, drawn with fills
+#define KEY_TOP    20           // playfield rows a key may draw on
+#define KEY_BOTTOM 140
+
 
 class Key
 {
@@ -46,6 +50,8 @@ public:
     virtual ~Key();
 
 private:
+    void drawFill(int16_t top, int16_t bottom);
+
     int16_t x;
     int16_t y;
     uint16_t width;
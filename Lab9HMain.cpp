@@ -11,9 +11,9 @@
 #include "../inc/Clock.h"
 #include "../inc/LaunchPad.h"
 #include "../inc/TExaS.h"
+#include "../inc/UART.h"
 #include "../inc/Timer.h"
 #include "../inc/SlidePot.h"
-#include "../inc/DAC5.h"
 #include "SmallFont.h"
 #include "LED.h"
 #include "Switch.h"
@@ -22,15 +22,26 @@
 #include "Key.h"
 #include "Row.h"
 #include "Sprite.h"
+#include "GameClock.h"
+#include "Judge.h"
+#include "Debounce.h"
+#include "SpscRing.h"
+#include "Chart.h"
+#include "Endless.h"
+#include "Recorder.h"
+#include "LcdStats.h"
+#include "Profile.h"
+#include "LoadMeter.h"
 
 
 extern "C" void __disable_irq(void);
 extern "C" void __enable_irq(void);
 extern "C" void TIMG12_IRQHandler(void);
 extern "C" void TIMG6_IRQHandler(void);
-extern "C" void SysTick_Handler(void);
 
 void FSM_Handler();
+void drawGradeCounts();
+void drawMenu();
 
 #define B 0x0000
 #define W 0x0FFF
@@ -47,189 +58,72 @@ void FSM_Handler();
 //////////////////////////////////////////////////////////////
 
 // SOUND STUFF IS HERE
-
-// Twinkle Twinkle Notes
-#define C4  9556   // 261.6 Hz
-#define G4  6378   // 392 Hz
-#define A4 5682   // 440 Hz
-#define F4  7159   // 349.2 Hz
-#define E4  7584   // 329.6 Hz
-#define D4  8513   // 293.7 Hz
-
-// Happy Birthday - uses same notes as above plus a few more (C5 and Bb4)
-
-#define Bflat4 5062 // 493.88 Hz
-#define C5 4778 // 523.25 Hz
+// Note pitches are MIDI numbers in the charts, see Charts.cpp and Sound_NoteIncrement
 
 // SlidePot - ADC Stuff
 
 SlidePot Sensor(1832,176); // Calibrated
 uint32_t Reading;        // 12-bit ADC
-uint32_t ADCflag = 0;
 
 uint32_t ADCValues[32];
 uint32_t ADCValuesIndex = 0;
 
 // Score
 
-uint16_t score = 0;
+uint32_t score = 0;
 
 ////////////////////////////////////////////////////////////////
 
 uint32_t lives = 3; // Decremented in FSM handler
 
-// FSM stuff
+// Game state machine
+
+#define MODE_MENU 0
+#define MODE_GAME 1
+#define MODE_END  2
 
 uint32_t language = 0; // false for English, true for Spanish
 uint32_t china = 0;
-uint32_t stateIndex = 0;
-uint32_t clickedKeys = 0;
-
-
-struct State {
-
-    uint32_t mode;  // 0 for menu, 1 for game, 2 lastnote, 3 done
-    uint32_t outputKeys;  // indicates what keys should be pressed
-    uint32_t noteFrequency; // indicates the frequency of the note being played
-    uint32_t next[4];
-
-};
-
-
-const State FSM[91] =         // CHANGE FSM SIZE!!!
-{
-
-     {0, 0, 0, {1, 2, 56, 0}},    // English Menu Song 1           0
-     {0, 0, 0, {0, 3, 56, 1}},    // Spanish Menu Song 1           1         MAKE SURE THE 8 IS THE FIRST INDEX OF SONG 1 (56 NOW)
-     {0, 0, 0, {3, 0, 59, 2}},    // English Menu Song 2           2         REPLACE THE 40 WITH STARTING INDEX OF SONG 2
-     {0, 0, 0, {2, 1, 59, 3}},    // Spanish Menu Song 2           3
-     {3, 0, 0, {0, 0, 0, 0}},     // English Lose                  4
-     {3, 0, 0, {1, 1, 1, 1}},     // Spanish Lose                  5
-     {3, 0, 0, {0, 0, 0, 0}},     // English Win                   6
-     {3, 0, 0, {1, 1, 1, 1}},     // Spanish Win                   7
-
-     // For empty space, make sure 0 for frequency works. If not, add a conditional where it just doesn't call the SoundStart method if frequency is 0
-
-     {1, 8, C4, {9, 4, 5, 0}},               // First state of Song 1                    8
-     {1, 8, C4, {10, 4, 5, 0}},              //                                          9
-     {1, 2, G4, {11, 4, 5, 0}},              //                                          10
-     {1, 2, G4, {12, 4, 5, 0}},              //                                          11
-     {1, 1, A4, {13, 4, 5, 0}},              //                                          12
-     {1, 1, A4, {14, 4, 5, 0}},              //                                          13
-     {1, 10, G4, {15, 4, 5, 0}},             //                                          14
-     {1, 0, 1, {16, 4, 5, 0}},               //                                          15
-
-     {1, 1, F4, {17, 4, 5, 0}},              //                                          16
-     {1, 1, F4, {18, 4, 5, 0}},              //                                          17
-     {1, 2, E4, {19, 4, 5, 0}},              //                                          18
-     {1, 2, E4, {20, 4, 5, 0}},              //                                          19
-     {1, 4, D4, {21, 4, 5, 0}},              //                                          20
-     {1, 4, D4, {22, 4, 5, 0}},              //                                          21
-     {1, 10, C4, {23, 4, 5, 0}},             //                                          22
-     {1, 0, 1, {24, 4, 5, 0}},               //                                         23
-
-     {1, 2, G4, {25, 4, 5, 0}},              //                                          24
-     {1, 2, G4, {26, 4, 5, 0}},              //                                          25
-     {1, 4, F4, {27, 4, 5, 0}},              //                                          26
-     {1, 4, F4, {28, 4, 5, 0}},              //                                          27
-     {1, 8, E4, {29, 4, 5, 0}},              //                                          28
-     {1, 8, E4, {30, 4, 5, 0}},              //                                          29
-     {1, 5, D4, {31, 4, 5, 0}},              //                                          30
-     {1, 0, 1, {32, 4, 5, 0}},               //                                          31
-
-     {1, 2, G4, {33, 4, 5, 0}},              //                                          32
-     {1, 2, G4, {34, 4, 5, 0}},              //                                          33
-     {1, 4, F4, {35, 4, 5, 0}},              //                                          34
-     {1, 4, F4, {36, 4, 5, 0}},              //                                          35
-     {1, 8, E4, {37, 4, 5, 0}},              //                                          36
-     {1, 8, E4, {38, 4, 5, 0}},              //                                          37
-     {1, 5, D4, {39, 4, 5, 0}},              //                                          38
-     {1, 0, 1, {40, 4, 5, 0}},               //                                          39
-
-     {1, 8, C4, {41, 4, 5, 0}},              //                                          40
-     {1, 8, C4, {42, 4, 5, 0}},              //                                          41
-     {1, 2, G4, {43, 4, 5, 0}},              //                                          42
-     {1, 2, G4, {44, 4, 5, 0}},              //                                          43
-     {1, 1, A4, {45, 4, 5, 0}},              //                                          44
-     {1, 1, A4, {46, 4, 5, 0}},              //                                          45
-     {1, 10, G4, {47, 4, 5, 0}},             //                                          46
-     {1, 0, 1, {48, 4, 5, 0}},               //                                          47
-
-     {1, 1, F4, {49, 4, 5, 0}},              //                                          48
-     {1, 1, F4, {50, 4, 5, 0}},              //                                          49
-     {1, 2, E4, {51, 4, 5, 0}},              //                                          50
-     {1, 2, E4, {52, 4, 5, 0}},              //                                          51
-     {1, 4, D4, {53, 4, 5, 0}},              //                                          52
-     {1, 4, D4, {54, 4, 5, 0}},              //                                          53
-     {1, 15, C4, {55, 4, 5, 0}},             //                                          54
-     {2, 0, 1, {4, 5, 6, 7}},                // LastNote1                                55
-
-     {1, 0, 1, {57, 4, 5, 0}},               //  EMPTY START BUFFER! SONG STARTS HERE    56
-     {1, 0, 1, {58, 4, 5, 0}},               //                                          57
-     {1, 0, 1, {8, 4, 5, 0}},                //                                          58
-
-//////////////////////////////////////////////////////////////////////////////////////////////////////
-
-     {1, 0, 1, {60, 4, 5, 0}},               //  First state of Song 2 (Empty)           59
-     {1, 0, 1, {61, 4, 5, 0}},               //  (Empty)                                 60
-     {1, 0, 1, {62, 4, 5, 0}},                //  (Empty)                                 61
-
-     {1, 8, C4, {63, 4, 5, 0}},              //                                          62
-     {1, 8, C4, {64, 4, 5, 0}},              //                                          63
-     {1, 4, D4, {65, 4, 5, 0}},              //                                          64
-     {1, 8, C4, {66, 4, 5, 0}},              //                                          65
-     {1, 2, F4, {67, 4, 5, 0}},              //                                          66
-     {1, 10, E4, {68, 4, 5, 0}},              //                                          67
-     {1, 0, 1, {69, 4, 5, 0}},               //                                          68
-
-     {1, 8, C4, {70, 4, 5, 0}},              //                                          69
-     {1, 8, C4, {71, 4, 5, 0}},              //                                          70
-     {1, 4, D4, {72, 4, 5, 0}},              //                                          71
-     {1, 8, C4, {73, 4, 5, 0}},              //                                          72
-     {1, 1, G4, {74, 4, 5, 0}},              //                                          73
-     {1, 5, F4, {75, 4, 5, 0}},              //                                          74
-     {1, 0, 1, {76, 4, 5, 0}},               //                                          75
-
-     {1, 8, C4, {77, 4, 5, 0}},              //                                          76
-     {1, 8, C4, {78, 4, 5, 0}},              //                                          77
-     {1, 1, C5, {79, 4, 5, 0}},              //                                          78
-     {1, 2, A4, {80, 4, 5, 0}},              //                                          79
-     {1, 4, F4, {81, 4, 5, 0}},              //                                          80
-     {1, 8, E4, {82, 4, 5, 0}},              //                                          81
-     {1, 9, D4, {83, 4, 5, 0}},              //                                          82
-     {1, 0, 1, {84, 4, 5, 0}},               //                                          83
-
-     {1, 1, Bflat4, {85, 4, 5, 0}},          //                                          84
-     {1, 1, Bflat4, {86, 4, 5, 0}},          //                                          85
-     {1, 2, A4, {87, 4, 5, 0}},              //                                          86
-     {1, 8, F4, {88, 4, 5, 0}},              //                                          87
-     {1, 4, G4, {89, 4, 5, 0}},              //                                          88
-     {1, 11, F4, {90, 4, 5, 0}},             //                                          89
-     {2, 0, 1, {4, 5, 6, 7}},                //   Last Note Song 2                       90
-
-
-};
-
-// FSM INDICES:
-// Game next 0 for next note, 1 for english lose, 2 for spanish lose
-// Last note next: 0 english lose, 1 spanish lose, 2 english win, 3 spanish win
-// Menu, 0 toggle language, 1 toggle song, 2 start game
-// Done, click anything means go back to menu
-
-
-/// Song Inits: /////////////////////////////////////////////////////////////
-
-uint8_t song1[] = {0, 0, 0, 8, 8, 2, 2, 1, 1, 10, 0, 1, 1, 2, 2, 4, 4, 10, 0, 2, 2, 4, 4, 8, 8, 5, 0, 2, 2, 4, 4, 8, 8, 5, 0, 8, 8, 2, 2, 1, 1, 10, 0, 1, 1, 2, 2, 4, 4, 15, 0};
-uint16_t songLength1 = 51;
-Row rowArray1[51];
-
-uint8_t song2[] = {0, 0, 0, 8, 8, 4, 8, 2, 10, 0, 8, 8, 4, 8, 1, 5, 0, 8, 8, 1, 2, 4, 8, 9, 0, 1, 1, 2, 8, 4, 11, 0};
-uint16_t songLength2 = 32;
-Row rowArray2[32];
-
-uint8_t* song;
-uint16_t songLength = 51;
-Row* rowArray;
+uint32_t mode = MODE_MENU;  // written by the game ISR only
+uint32_t chartIndex = 0;    // menu selection, index into Charts[]
+bool won = false;           // end screen shows win or lose
+uint32_t clickedKeys = 0;   // full clicks seen this frame, used by the menu and end screens
+
+// Timing judgement
+#define HITY 110    // rowY of a one-row tile at the ideal hit time, it sits on the bottom line
+#define ROWPITCH 30 // pixels per chart row, a hold note is a multiple of this tall
+#define SCROLL 2    // pixels per game frame for charts, endless mode speeds up
+#define SOAK 0      // 1 plays every row on time by itself, leave endless mode running as a soak test
+#define NOTE_LEAD GAMECLOCK_MS(10)  // a hit's note sounds this long after its frame started, over SOUND_LEAD
+
+Judge judge(JUDGE_PERFECT_MS, JUDGE_GREAT_MS, JUDGE_GOOD_MS);
+uint16_t judgedRow = 0;     // next row to be judged, can be ahead of bottomRow
+uint8_t scroll = SCROLL;    // pixels per game frame
+uint32_t scrollTime;        // clock time the rows were last moved to
+uint32_t scrollCarry;       // bus cycles times scroll moved short of a pixel, under GAMECLOCK_FRAME
+bool judgedRowHit = false;  // feedback (gray keys, note) already given for judgedRow
+uint8_t releasedKeys = 0;   // lanes released since the hold note's head was hit
+
+// Hold note being held down, its head has been judged and its tail is still coming
+uint8_t holdLanes = 0;      // 0 when no hold is in progress
+uint16_t holdRow;
+Grade holdGrade;
+uint32_t hitNote;           // Sound_Chord of the last row hit, held with a hold
+
+
+/// Rows: //////////////////////////////////////////////////////////////////
+
+// Only the rows on screen exist. They live in a ring indexed by row number
+// and are filled from the chart just before they scroll on.
+#define ROWSLOTS 8      // power of 2, more than the 5 that fit on screen
+#define ROW(i) rowArray[(i) & (ROWSLOTS-1)]
+Row rowArray[ROWSLOTS];
+uint8_t rowPitch[ROWSLOTS];
+ChartReader reader;
+uint16_t songLength = 51;   // rows in the chart being played
+uint16_t songNotes = 51;    // rows of it with keys, the ones that are judged
+Endless endless;
+bool endlessRun = false;    // rows come from endless rather than reader, chartIndex == ChartCount
 
 uint16_t topRow = 0; //topRow is a later note, so higher index
 uint16_t bottomRow = 0;
@@ -240,10 +134,36 @@ uint16_t bottomRow = 0;
 uint16_t g6counter = 0;
 //bool switchingMode = true; //needs mode initialization if true
 bool startingGame = true; //only used to initialize menu at beginning
-bool switchingToMenu, switchingToGame, switchingToEnd; //communicate between interrupt and main
+bool switchingToMenu, switchingToGame, switchingToEnd; //set by main from EVENT_MODE
 bool switchingMenuState = false; //needs to redraw menu when switching menu states
+uint32_t screenMode = MODE_MENU;   // mode the main loop is drawing, follows EVENT_MODE
+
+// Events between the ISRs and main. Each queue has exactly one producer and
+// one consumer, so nothing is lost and no flag is overwritten mid-update.
+enum EventType {
+    EVENT_PRESS,    // TIMG6 -> TIMG12, data is the lane, time is when it went down
+    EVENT_CLICK,    // TIMG6 -> TIMG12, data is the mask of keys released, time is when
+    EVENT_MODE,     // TIMG12 -> main, data is the new mode
+    EVENT_MENU,     // TIMG12 -> main, language or chartIndex changed
+    EVENT_JUDGED    // TIMG12 -> main, data is the row's Grade
+};
+
+struct GameEvent {
+    uint8_t type;
+    uint8_t data;
+    uint32_t time;
+};
+
+SpscRing<GameEvent, 16> inputEvents;    // TIMG6 -> TIMG12
+SpscRing<GameEvent, 16> gameEvents;     // TIMG12 -> main
+
+void postGameEvent(uint8_t type, uint32_t data){
+    GameEvent e = {type, (uint8_t)data, GameClock_Now()};
+    gameEvents.push(e);
+}
 
-uint32_t startTime,stopTime, Offset, Converttime;
+Grade lastGrade = Perfect;
+bool gradeChanged = false;
 
 Sprite sprite1;
 
@@ -293,78 +213,71 @@ const char *Phrases[3][4]={
 };
 
 
-void generateNewRow(){
-
-}
-
-void generateRowArray(){
-    for(int i = 0; i < songLength1; i++){
-        rowArray1[i].initializeRow(song1[i], 0);
+// Fills row slot i from the chart, O(1)
+void generateNewRow(uint16_t i){
+    ChartRow next = {0, 0, 1};
+    if(endlessRun){
+        endless.next(&next);
     }
-    for(int i = 0; i < songLength2; i++){
-        rowArray2[i].initializeRow(song2[i], 0);
+    else{
+        reader.next(&next);
     }
-
+    ROW(i).initializeRow(next.lanes, 0, next.length*ROWPITCH);
+    rowPitch[i & (ROWSLOTS-1)] = next.pitch;
 }
 
+// Called from the game ISR when a game starts, the main loop draws the rows
 void startGameRows(){
-
+    endlessRun = (chartIndex == ChartCount);
+    if(endlessRun){
+        endless.start(Random32());
+        songLength = 0xFFFF;
+    }
+    else{
+        reader.start(&Charts[chartIndex]);
+        songLength = Charts[chartIndex].rows;
+        songNotes = Charts[chartIndex].keyNotes;
+    }
+    scroll = SCROLL;
+    scrollTime = GameClock_FrameStart();
+    scrollCarry = 0;
     bottomRow = 0;
-    topRow = 3;
     lives = 3;
-
-    ST7735_FillScreen(0xFFFF);            // set screen to white to reset screen
-
-    for(uint8_t j = 0; j < songLength; j++){
-        for(uint8_t i = 0; i < 4; i++){
-            if(rowArray[j].getKey(i).getArray() == Key::gray_key){
-                rowArray[j].getKey(i).switchToUnclicked();
-            }
-        }
-    }
-
-
-    rowArray[0].setOnScreen();
-    rowArray[0].setRowY(110);
-    rowArray[0].drawRow();
-
-    rowArray[1].setOnScreen();
-    rowArray[1].setRowY(80);
-    rowArray[1].drawRow();
-
-
-    rowArray[2].setOnScreen();
-    rowArray[2].setRowY(50);
-    rowArray[2].drawRow();
-
-    rowArray[3].setOnScreen();
-    rowArray[3].setRowY(20);
-    rowArray[3].drawRow();
-
-
-
-
-    //needsRedraw = false;
+    score = 0;
+    holdLanes = 0;
+
+    // stack rows up from the bottom line until the screen is full
+    uint16_t i = 0;
+    int16_t top = HITY + ROWPITCH;
+    do{
+        generateNewRow(i);
+        top -= ROW(i).getRowHeight();
+        ROW(i).setOnScreen();
+        ROW(i).setRowY(top);
+        i++;
+    }while(top > 20 && i < songLength);
+    topRow = i - 1;
 }
 
 void adjustVisible(){
-    if(bottomRow >= songLength)
+    if(!endlessRun && bottomRow >= songLength)
         return;
 //    if(topRow == songLength - 1 && rowArray[topRow].getRowY() > 20 && rowArray[topRow].getRowY() < 140){//last note is visible
 //        ST7735_DrawFastHLine(0, rowArray[topRow].getRowY() - 2, 128, 0xFFFF);
 //        ST7735_DrawFastHLine(0, rowArray[topRow].getRowY() - 1, 128, 0xFFFF);
 //    }
-    if(rowArray[bottomRow].getRowY() > 140){
-        rowArray[bottomRow].setOffScreen();
+    if(ROW(bottomRow).getRowY() > 140){
+        ROW(bottomRow).setOffScreen();
         //rowArray[bottomRow].clearRow();
         bottomRow++;
     }
 
-    if(rowArray[topRow].getRowY() > 20 && topRow < songLength){
-        rowArray[topRow + 1].setOnScreen();
-        rowArray[topRow + 1].setRowY(rowArray[topRow].getRowY() - 30);
+    if(ROW(topRow).getRowY() > 20 && (endlessRun || topRow + 1 < songLength)){
+        generateNewRow(topRow + 1);
+        ROW(topRow + 1).setOnScreen();
+        ROW(topRow + 1).setRowY(ROW(topRow).getRowY() - ROW(topRow + 1).getRowHeight());
         topRow++;
-        rowArray[topRow].drawRow();
+        ROW(topRow).drawRow();
     }
 }
 
@@ -374,8 +287,8 @@ void moveRows(int16_t y){
 //            rowArray[i].moveRow(y);
 //        }
 //    }
-    for(int i = bottomRow; i <= topRow; i++){
-        rowArray[i].moveRow(y);
+    for(uint16_t i = bottomRow; i != (uint16_t)(topRow + 1); i++){    // row numbers wrap in endless mode
+        ROW(i).moveRow(y);
     }
 
     //adjustVisible();
@@ -383,10 +296,23 @@ void moveRows(int16_t y){
     //needsRedraw = true;
 }
 
+// Pixels the rows move this frame: the time since they last moved on the
+// game clock at scroll pixels a GAMECLOCK_FRAME, with what is short of
+// a pixel carried. A late or missed frame catches up.
+int16_t scrolled(){
+    uint32_t now = GameClock_FrameStart();
+    scrollCarry += (now - scrollTime)*scroll;
+    scrollTime = now;
+    int16_t pixels = scrollCarry/GAMECLOCK_FRAME;
+    scrollCarry -= pixels*GAMECLOCK_FRAME;
+    return pixels;
+}
+
 // games  engine runs at 30Hz
 
-void TIMG12_IRQHandler(void){uint32_t pos,msg;
+void TIMG12_IRQHandler(void){
   if((TIMG12->CPU_INT.IIDX) == 1) { // this will acknowledge
+    LOAD_ISR(LOAD_TIMG12, GAMECLOCK_FRAME-1 - TIMG12->COUNTERREGS.CTR);
     GPIOB->DOUTTGL31_0 = GREEN; // toggle PB27 (minimally intrusive debugging)
     GPIOB->DOUTTGL31_0 = GREEN; // toggle PB27 (minimally intrusive debugging)
 // game engine goes here
@@ -398,12 +324,16 @@ void TIMG12_IRQHandler(void){uint32_t pos,msg;
     // NO LCD OUTPUT IN INTERRUPT SERVICE ROUTINES
     //GPIOB->DOUTTGL31_0 |= (1<<16);
 
-    //startTime = SysTick->VAL;
-    if(FSM[stateIndex].mode==1 || FSM[stateIndex].mode==2){
-        moveRows(2);
+    GameClock_Tick();
+    LcdStats_Latch();
+    LoadMeter_Latch();
+    PROFILE_ZONE("TIMG12");     // after the tick, GameClock_Now is a frame behind before it
+    if(mode == MODE_GAME){
+        if(endlessRun){
+            scroll = endless.getScroll();
+        }
+        moveRows(scrolled());
     }
-    //stopTime = SysTick->VAL;
-    //Converttime = ((startTime-stopTime)&0x0FFFFFF)-Offset; // in bus cycles
     FSM_Handler();
 
 
@@ -411,15 +341,6 @@ void TIMG12_IRQHandler(void){uint32_t pos,msg;
  }
 }
 
-void SysTick_Handler(void){ // called at 11 kHz
-
-    const uint8_t wave[32] = {16,19,22,24,27,28,30,31,31,31,30,28,27,24,22,19,16,13,10,8,5,4,2,1,1,1,2,4,5,8,10,13};
-    static uint32_t i=0;
-    DAC5_Out((wave[i]*Reading)/4095);
-    i = (i+1) & 0x1F; // Cycles
-
-}
-
 //uint8_t song[] = {15, 3, 5, 0, 7, 8, 11, 14, 15, 14, 11, 5, 10, 12, 1, 10, 7, 0, 13, 8, 4, 6, 9, 4, 10, 14, 5, 5, 1, 0, 8, 7, 13, 1, 10, 4, 12, 14, 8, 1, 0, 10, 6, 10, 11, 12, 7, 6, 15, 9};
 //uint16_t songLength = 50;
 //uint16_t topRow = 0; //topRow is a later note, so higher index
@@ -428,15 +349,22 @@ void SysTick_Handler(void){ // called at 11 kHz
 
 
 // Globals
-uint32_t risingEdge1 = 0;    // Used in Timer Handler
-uint32_t fallingEdge1 = 0;
-uint32_t risingEdge2 = 0;
-uint32_t fallingEdge2 = 0;
-uint32_t risingEdge3 = 0;
-uint32_t fallingEdge3 = 0;
-uint32_t risingEdge4 = 0;
-uint32_t fallingEdge4 = 0;
-
+#define KEYDIV 4            // keys sampled every 4th TIMG6 interrupt, 1kHz
+Debounce keys;              // lane n is bit n, Key1 is lane 3 ... Key4 is lane 0
+
+// LED outputs toggled by a press, indexed by the lane bits 2-0 (PA27-PA25)
+const uint32_t KeyLEDA[8] = {0, 1<<27, 1<<26, (1<<27)|(1<<26), 1<<25,
+                             (1<<27)|(1<<25), (1<<26)|(1<<25), (1<<27)|(1<<26)|(1<<25)};
+
+// Both ports are read once and the key bits gathered into a lane word
+uint32_t readKeys(void){
+    uint32_t a = GPIOA->DIN31_0;
+    uint32_t b = GPIOB->DIN31_0;
+    return ((b>>9)&0x08)    // PB12 Key1, lane 3
+         | ((b>>15)&0x04)   // PB17 Key2, lane 2
+         | ((a>>30)&0x02)   // PA31 Key3, lane 1
+         | ((a>>12)&0x01);  // PA12 Key4, lane 0
+}
 
 
 int mainSwitch(void) {    // main switch testing
@@ -467,101 +395,70 @@ int mainSwitch(void) {    // main switch testing
 }
 
 
+// Queues an input for the game ISR and logs it if capturing
+void pushInput(uint8_t type, uint8_t data, uint32_t time){
+    GameEvent e = {type, data, time};
+    inputEvents.push(e);
+    Recorder_Input(type, data, 0, time);
+}
+
+// Press LEDs, lane 3 is on PB16 and lanes 2-0 on PA25-27
+void toggleKeyLEDs(uint32_t lanes){
+    if(lanes & 0x08){
+        GPIOB->DOUTTGL31_0 = (1<<16);
+    }
+    GPIOA->DOUTTGL31_0 = KeyLEDA[lanes & 0x07];
+}
+
+void sampleKeys(void){
+    keys.sample(readKeys());
+    uint32_t pressed = keys.pressed();
+    uint32_t now = GameClock_Now();
+    if(pressed){
+        for(uint8_t lane = 0; lane < JUDGE_LANES; lane++){
+            if(pressed & (1<<lane)){
+                pushInput(EVENT_PRESS, lane, now);
+            }
+        }
+        toggleKeyLEDs(pressed);
+    }
+    if(keys.released()){    // menu and end screens act on a full click
+        pushInput(EVENT_CLICK, keys.released(), now);
+    }
+}
+
+// Recorded inputs go in a frame early, the game ISR holds each one until its frame
+void replayInputs(void){
+    RecordEvent r;
+    while(Recorder_Next(&r, GameClock_Now() + GAMECLOCK_FRAME)){
+        if(r.type == RECORD_POT){
+            Reading = r.value;
+        }
+        else{
+            GameEvent e = {r.type, r.data, r.time};
+            inputEvents.push(e);
+            if(r.type == EVENT_PRESS){
+                toggleKeyLEDs(1<<r.data);
+            }
+        }
+    }
+}
+
 void TIMG6_IRQHandler(void)
 {
     if((TIMG6->CPU_INT.IIDX) == 1) {
-
+        LOAD_ISR(LOAD_TIMG6, TIMG6->COUNTERREGS.LOAD - TIMG6->COUNTERREGS.CTR);
+        PROFILE_ZONE("TIMG6");
         g6counter++;
-        if(g6counter == 40)
+        if(g6counter == KEYDIV)
         {
             g6counter = 0;
-            //GPIOB->DOUTTGL31_0 |= (1<<16);
-            // Key 1
-
-
-
-                    uint32_t userInput1 = GPIOB->DIN31_0 & (1<<12);
-                    if(userInput1!=0 && risingEdge1 == 0)
-                    {
-                        risingEdge1=1;
-                    }
-                    if(userInput1==0 && risingEdge1 ==1)
-                    {
-                        fallingEdge1=1;
-                    }
-                    if(risingEdge1==1 && fallingEdge1==1)
-                    {
-                        GPIOB->DOUTTGL31_0 |= (1<<16);
-                        clickedKeys|=8; // Specific Key
-
-//                        risingEdge1=0;
-//                        fallingEdge1=0;
-
-                    }
-
-                    // Key 2
-
-                    uint32_t userInput2 = GPIOB->DIN31_0 & (1<<17);
-                    if(userInput2!=0 && risingEdge2 == 0)
-                    {
-                        risingEdge2=1;
-                    }
-                    if(userInput2==0 && risingEdge2 ==1)
-                    {
-                        fallingEdge2=1;
-                    }
-                    if(risingEdge2==1 && fallingEdge2==1)
-                    {
-                        GPIOA->DOUTTGL31_0 |= (1<<25);
-                        clickedKeys|=4; // Specific Key
-
-            //            risingEdge2=0;
-            //            fallingEdge2=0;
-
-                    }
-
-                    // Key 3
-
-                    uint32_t userInput3 = GPIOA->DIN31_0 & (1<<31);
-                    if(userInput3!=0 && risingEdge3 == 0)
-                    {
-                        risingEdge3=1;
-                    }
-                    if(userInput3==0 && risingEdge3 ==1)
-                    {
-                        fallingEdge3=1;
-                    }
-                    if(risingEdge3==1 && fallingEdge3==1)
-                    {
-                        GPIOA->DOUTTGL31_0 |= (1<<26);
-                        clickedKeys|=2; // Specific Key
-
-            //            risingEdge3=0;
-            //            fallingEdge3=0;
-
-                    }
-
-
-                    // Key 4
-
-                    uint32_t userInput4 = GPIOA->DIN31_0 & (1<<12);
-                    if(userInput4!=0 && risingEdge4 == 0)
-                    {
-                        risingEdge4=1;
-                    }
-                    if(userInput4==0 && risingEdge4 ==1)
-                    {
-                        fallingEdge4=1;
-                    }
-                    if(risingEdge4==1 && fallingEdge4==1)
-                    {
-                        GPIOA->DOUTTGL31_0 |= (1<<27);
-                        clickedKeys|=1; // Specific Key
-
-            //            risingEdge4=0;
-            //            fallingEdge4=0;
-
-                    }
+            if(RECORDER_MODE == RECORDER_REPLAY){
+                replayInputs();
+            }
+            else{
+                sampleKeys();
+            }
         }
         ADCValues[ADCValuesIndex] = Sensor.In();
         ADCValuesIndex++;
@@ -571,320 +468,317 @@ void TIMG6_IRQHandler(void)
                 sum += ADCValues[i];
             }
             uint32_t avgReading = sum/32;
+            uint32_t lastReading = Reading;
+            // hysteresis, a reading on the edge of a volume step doesn't flicker
             if(avgReading > Reading + 50 || (Reading >= 50 && (avgReading < Reading - 50))){
                 Reading = avgReading;
             }
-            Reading = sum/32;
+            if(RECORDER_MODE == RECORDER_REPLAY){
+                Reading = lastReading;      // the recording sets the volume
+            }
+            else if(Reading != lastReading){
+                Recorder_Input(RECORD_POT, 0, Reading, GameClock_Now());
+            }
             ADCValuesIndex = 0;
+            Sound_Volume(Reading);
         }
         //Reading = Sensor.In();
         Sensor.Save(Reading);   // Updates the data and also sets flag within the sensor class
-        ADCflag = 1;
 
 
     }
 }
 
 
-// Will control the state, gets called each time the "row reached bottom" semaphore is set (indicating the player should have clicked the right keys by now)
-void FSM_Handler() {
-
-    if(FSM[stateIndex].mode==1) // MAKE SURE TO ADD CONDITIONAL TO CHECK IF AT BOTTOM !!!!!!!!
-    {
-        if(clickedKeys == FSM[stateIndex].outputKeys){
-            for(uint8_t i = 0; i < 4; i++){
-                if(rowArray[bottomRow].getKey(i).getArray() == Key::black_key){
-                    rowArray[bottomRow].getKey(i).switchToClicked();
-                }
-            }
-
-            if(FSM[stateIndex].noteFrequency != 1){
-                Sound_Start(FSM[stateIndex].noteFrequency);
-            }
-            //OUTPUT SOUND HERE (OR CALL SOMETHING THAT WILL)
-        }
-
-
-        if(rowArray[bottomRow].getRowY() == 140){
-            if(clickedKeys != FSM[stateIndex].outputKeys)
-            {
-                lives--;
-            }
-            else{
-                score+=100;
-//                Sound_Start(FSM[stateIndex].noteFrequency);
-//                Sound_Stop();
-            }
+// Clock counts from this frame's start until a tile edge now at rowY reaches HITY,
+// rows move scroll pixels per frame and are already scrollCarry/GAMECLOCK_FRAME of a
+// pixel past rowY. A hold can be 255 rows tall: its tail is thousands of pixels up,
+// minutes away, further than the 32-bit clock reaches, so this is 64-bit.
+int64_t rowHitDelay(int16_t rowY){
+    int64_t pixels = (int32_t)HITY - rowY;
+    return (pixels*GAMECLOCK_FRAME - scrollCarry)/scroll;
+}
 
-            if(lives==0)
-            {
-                if(language==0)
-                {
-                    stateIndex = FSM[stateIndex].next[1];
-                    //switchingMode = true;
-                    switchingToEnd = true;
-                }
-                else
-                {
-                    stateIndex = FSM[stateIndex].next[2];
-                    //switchingMode = true;
-                    switchingToEnd = true;
-                }
-            }
-            else
-            {
-                stateIndex = FSM[stateIndex].next[0];
-            }
+// Time at which a tile edge now at rowY reaches HITY, for rows near enough to compare
+uint32_t rowHitTime(int16_t rowY){
+    return GameClock_FrameStart() + (uint32_t)rowHitDelay(rowY);
+}
 
-            risingEdge1=0;
-            fallingEdge1=0;
-            risingEdge2=0;
-            fallingEdge2=0;
-            risingEdge3=0;
-            fallingEdge3=0;
-            risingEdge4=0;
-            fallingEdge4=0;
+// Percent of a perfect run for a chart, points for endless mode
+uint32_t shownScore(){
+    if(endlessRun){
+        return score;
+    }
+    return score/songNotes;
+}
 
-            clickedKeys = 0;    // Reset to 0 because done
+// A hold can break in the same frame a row is missed
+void loseLife(){
+    if(lives){
+        lives--;
+        if(lives){
+            Sound_Killed();
+        }
+        else{
+            Sound_Explosion();
         }
-
     }
+}
 
-    else if(FSM[stateIndex].mode==0)
+// Grades a row whose Good window has closed and scores it, a hold
+// whose head was hit is scored once its tail passes. The next row on
+// screen that wants keys can claim presses in this row's window.
+void scoreRow(Row &row, uint8_t lanes, uint32_t hitTime){
+    uint8_t nextLanes = 0;
+    uint32_t nextHitTime = 0;
+    for(uint16_t i = judgedRow + 1; i != (uint16_t)(topRow + 1); i++){
+        Row &next = ROW(i);
+        if(next.getKeyColors()){
+            nextLanes = next.getKeyColors();
+            nextHitTime = rowHitTime(next.getRowY() + next.getRowHeight() - ROWPITCH);
+            break;
+        }
+    }
+    Grade grade = judge.judgeRow(lanes, hitTime, nextLanes, nextHitTime);
+    if(grade == Miss)
     {
-        Sound_Start(1);
-        score = 0;
-        if(clickedKeys == 4)
-        {
-
-            stateIndex = FSM[stateIndex].next[0];
-            switchingMenuState = true;
-            if(language == 0)
-                language = 1;
-            else if(language==1)
-            {
-                language = 0;
-            }
-            //language = !language;
-
+        loseLife();
+        score += Judge::points(grade);
+        postGameEvent(EVENT_JUDGED, grade);
+        if(judgedRowHit){
+            Sound_Release(hitNote);     // hit, then a stray press made it a Miss
         }
-        else if(clickedKeys == 2)
-        {
-            stateIndex = FSM[stateIndex].next[1];
-            switchingMenuState = true;
+    }
+    else if(row.getRowHeight() > ROWPITCH && !(releasedKeys & lanes))
+    {
+        holdLanes = lanes;      // graded when the tail passes, the note sounds until then
+        holdRow = judgedRow;
+        holdGrade = grade;
+    }
+    else if(row.getRowHeight() > ROWPITCH)
+    {
+        loseLife();             // let go of the hold before its head was judged
+        judge.regrade(grade, Miss);
+        postGameEvent(EVENT_JUDGED, Miss);
+        Sound_Release(hitNote);
+    }
+    else
+    {
+        score += Judge::points(grade);
+        postGameEvent(EVENT_JUDGED, grade);
+        Sound_Release(hitNote);
+    }
+}
 
-            if(song == song2){
-                song = song1;
-                rowArray = rowArray1;
-                songLength = songLength1;
-            }
-            else if(song == song1){
-                song = song2;
-                rowArray = rowArray2;
-                songLength = songLength2;
-            }
+#if SOAK
+uint16_t soakRow = 0xFFFF;  // last row pressed by the soak test
+#endif
 
-        }
-        else if(clickedKeys == 1)
-        {
-            stateIndex = FSM[stateIndex].next[2];
-            //switchingMode = true;
-            switchingToGame = true;
-        }
+// Will control the state, gets called each time the "row reached bottom" semaphore is set (indicating the player should have clicked the right keys by now)
+GameEvent heldInput;        // input from after this frame started, used next frame
+bool inputHeld = false;
 
-        // Do nothing otherwise (stay in current state)
-        if(risingEdge1 && fallingEdge1){
-            risingEdge1=0;
-            fallingEdge1=0;
-            clickedKeys = 0;
+void FSM_Handler() {
+    // Only inputs from before the frame started are used, and rows are judged
+    // against the frame start, so a replay lands every input on the same frame
+    uint32_t frameStart = GameClock_FrameStart();
+    GameEvent e;
+    while(inputHeld || inputEvents.pop(&e)){
+        if(inputHeld){
+            e = heldInput;
         }
-        if(risingEdge2 && fallingEdge2){
-            risingEdge2=0;
-            fallingEdge2=0;
-            clickedKeys = 0;
+        inputHeld = ((int32_t)(e.time - frameStart) >= 0);
+        if(inputHeld){
+            heldInput = e;
+            break;
         }
-        if(risingEdge3 && fallingEdge3){
-            risingEdge3=0;
-            fallingEdge3=0;
-            clickedKeys = 0;
+        if(e.type == EVENT_PRESS){
+            judge.press(e.data, e.time);
         }
-        if(risingEdge4 && fallingEdge4){
-            risingEdge4=0;
-            fallingEdge4=0;
-            clickedKeys = 0;
+        else if(e.type == EVENT_CLICK){
+            clickedKeys |= e.data;
+            releasedKeys |= e.data;
         }
-//        risingEdge1=0;
-//        fallingEdge1=0;
-//        risingEdge2=0;
-//        fallingEdge2=0;
-//        risingEdge3=0;
-//        fallingEdge3=0;
-//        risingEdge4=0;
-//        fallingEdge4=0;
-
-//        clickedKeys = 0;    // Reset to 0 because done
     }
 
-    else if(FSM[stateIndex].mode==2) // MAKE SURE TO ADD CONDITIONAL TO CHECK IF AT BOTTOM !!!!!!!!
+
+    if(mode == MODE_GAME)
     {
-        //switchingMode = false;
-        uint32_t curstate = stateIndex;
-        if(clickedKeys == FSM[stateIndex].outputKeys){
-            for(uint8_t i = 0; i < 4; i++){
-                if(rowArray[bottomRow].getKey(i).getArray() == Key::black_key){
-                    rowArray[bottomRow].getKey(i).switchToClicked();
-                }
+        // a hold scores its head's grade once the tail passes, letting go early is a Miss
+        if(holdLanes){
+            int64_t untilTail = rowHitDelay(ROW(holdRow).getRowY());
+            if(untilTail <= 0){
+                score += Judge::points(holdGrade);
+                postGameEvent(EVENT_JUDGED, holdGrade);
+                holdLanes = 0;
+                Sound_Release(hitNote);
             }
-
-            //OUTPUT SOUND HERE (OR CALL SOMETHING THAT WILL)
-
-            if(FSM[stateIndex].noteFrequency != 1){
-                Sound_Start(FSM[stateIndex].noteFrequency);
+            else if((releasedKeys & holdLanes) && untilTail > (int32_t)GAMECLOCK_MS(JUDGE_GOOD_MS)){
+                loseLife();
+                judge.regrade(holdGrade, Miss);
+                postGameEvent(EVENT_JUDGED, Miss);
+                holdLanes = 0;
+                Sound_Release(hitNote);
             }
         }
 
-
-        if(rowArray[bottomRow].getRowY() == 140){
-            if(clickedKeys != FSM[curstate].outputKeys)
-            {
-                lives--;
-            }
-            else{
-//                Sound_Start(FSM[stateIndex].noteFrequency);
-//                Sound_Stop();
-                score+=100;
+        if(endlessRun || judgedRow < songLength){
+            Row &row = ROW(judgedRow);
+            uint8_t lanes = row.getKeyColors();
+            // a hold's head is its bottom ROWPITCH pixels
+            uint32_t hitTime = rowHitTime(row.getRowY() + row.getRowHeight() - ROWPITCH);
+
+#if SOAK
+            if(soakRow != judgedRow && (int32_t)(frameStart - hitTime) >= 0){
+                soakRow = judgedRow;
+                for(uint8_t lane = 0; lane < JUDGE_LANES; lane++){
+                    if(lanes & (1<<lane)){
+                        judge.press(lane, hitTime);
+                    }
+                }
             }
-
-            if(lives==0)
-            {
-                if(language==0)
-                {
-                    stateIndex = FSM[curstate].next[0];
-                    //switchingMode = true;
-                    switchingToEnd = true;
+#endif
+
+            if(!judgedRowHit && judge.isHit(lanes, hitTime)){
+                judgedRowHit = true;
+                releasedKeys &= ~lanes;
+                for(uint8_t i = 0; i < 4; i++){
+                    if(row.getKey(i).getArray() == Key::black_key){
+                        row.getKey(i).switchToClicked();
+                    }
                 }
-                else
-                {
-                    stateIndex = FSM[curstate].next[1];
-                    //switchingMode = true;
-                    switchingToEnd = true;
+
+                uint8_t pitch = rowPitch[judgedRow & (ROWSLOTS-1)];
+                if(pitch != 0){
+                    uint32_t notes = 0;     // a note for each key of a chord
+                    for(uint8_t lane = 0; lane < JUDGE_LANES; lane++){
+                        notes += (lanes>>lane) & 1;
+                    }
+                    hitNote = Sound_Chord(pitch, notes, frameStart + NOTE_LEAD);
                 }
+                Sound_Fastinvader1();
             }
-            else
-            {
-                if(language==0)
-                 {
-                     stateIndex = FSM[curstate].next[2];
-                     //switchingMode = true;
-                     switchingToEnd = true;
-                 }
-                 else
-                 {
-                     stateIndex = FSM[curstate].next[3];
-                     //switchingMode = true;
-                     switchingToEnd = true;
-                 }
-            }
 
-            risingEdge1=0;
-            fallingEdge1=0;
-            risingEdge2=0;
-            fallingEdge2=0;
-            risingEdge3=0;
-            fallingEdge3=0;
-            risingEdge4=0;
-            fallingEdge4=0;
+            // judge once the row's Good window has closed, an empty row
+            // (lead-in, rest or endless gap) just goes by unjudged
+            if((int32_t)(frameStart - hitTime) > (int32_t)GAMECLOCK_MS(JUDGE_GOOD_MS)){
+                if(lanes != 0){
+                    scoreRow(row, lanes, hitTime);
+                }
+                judgedRow++;
+                judgedRowHit = false;
+
+                clickedKeys = 0;    // Reset to 0 because done
+            }
+        }
 
-            clickedKeys = 0;    // Reset to 0 because done
+        if(lives == 0 || (!endlessRun && judgedRow == songLength && holdLanes == 0))
+        {
+            won = (lives != 0);
+            Sound_Off();
+            mode = MODE_END;
+            postGameEvent(EVENT_MODE, mode);
         }
 
     }
 
-
-    else if(FSM[stateIndex].mode==3)
+    else if(mode == MODE_MENU)
     {
-        Sound_Start(1);
-        if(clickedKeys!=0)
+        score = 0;
+        if(clickedKeys == 4)
         {
-            stateIndex = FSM[stateIndex].next[0];
-            //switchingMode = true;
-            switchingToMenu = true;
-                risingEdge1=0;
-                fallingEdge1=0;
-                risingEdge2=0;
-                fallingEdge2=0;
-                risingEdge3=0;
-                fallingEdge3=0;
-                risingEdge4=0;
-                fallingEdge4=0;
-
-                clickedKeys = 0;    // Reset to 0 because done
-        }
-
-        if(risingEdge1 && fallingEdge1){
-            risingEdge1=0;
-            fallingEdge1=0;
-            clickedKeys = 0;
+            language = !language;
+            postGameEvent(EVENT_MENU, 0);
         }
-        if(risingEdge2 && fallingEdge2){
-            risingEdge2=0;
-            fallingEdge2=0;
-            clickedKeys = 0;
-        }
-        if(risingEdge3 && fallingEdge3){
-            risingEdge3=0;
-            fallingEdge3=0;
-            clickedKeys = 0;
+        else if(clickedKeys == 2)
+        {
+            chartIndex++;
+            if(chartIndex > ChartCount){    // ChartCount is endless mode
+                chartIndex = 0;
+            }
+            postGameEvent(EVENT_MENU, 0);
         }
-        if(risingEdge4 && fallingEdge4){
-            risingEdge4=0;
-            fallingEdge4=0;
-            clickedKeys = 0;
+        else if(clickedKeys == 1)
+        {
+            startGameRows();
+            judge.reset();
+            judgedRow = 0;
+            judgedRowHit = false;
+#if SOAK
+            soakRow = 0xFFFF;
+#endif
+            mode = MODE_GAME;
+            postGameEvent(EVENT_MODE, mode);
         }
-//        risingEdge1=0;
-//        fallingEdge1=0;
-//        risingEdge2=0;
-//        fallingEdge2=0;
-//        risingEdge3=0;
-//        fallingEdge3=0;
-//        risingEdge4=0;
-//        fallingEdge4=0;
-//
-//        clickedKeys = 0;    // Reset to 0 because done
+
+        // Do nothing otherwise (stay in current state)
+        clickedKeys = 0;    // Reset to 0 because done
     }
 
-//    risingEdge1=0;
-//    fallingEdge1=0;
-//    risingEdge2=0;
-//    fallingEdge2=0;
-//    risingEdge3=0;
-//    fallingEdge3=0;
-//    risingEdge4=0;
-//    fallingEdge4=0;
-//
-//    clickedKeys = 0;    // Reset to 0 because done
+    else if(mode == MODE_END)
+    {
+        if(clickedKeys!=0)
+        {
+            chartIndex = 0;
+            mode = MODE_MENU;
+            postGameEvent(EVENT_MODE, mode);
+        }
+        clickedKeys = 0;    // Reset to 0 because done
+    }
+}
 
+////////////////////////////////////////////////////////////////////////////////////
 
+// Perfect/Great/Good/Miss totals under the end screen banner
+const char *GradeNames[2][4] = {
+  {"Miss", "Good", "Great", "Perfect"},
+  {"Fallo", "Bien", "Genial", "Perfecto"}
+};
 
+const char *EndlessNames[2] = {"Endless", "Sin fin"};
 
+// Language button and the selected chart's title, or endless mode after the last chart
+void drawMenu(){
+    if(language == 0){
+        ST7735_DrawBitmap(44, 65, Sprite::EnglishButton, 40, 20);
+    }
+    else{
+        ST7735_DrawBitmap(44, 65, Sprite::SpanishButton, 40, 20);
+    }
+    // the name starts at x=42, y=80, a little outside the title bitmaps
+    if(chartIndex == ChartCount){
+        ST7735_FillRect(42, 80, 44, 21, 0xFFFF);
+        ST7735_DrawString(7, 8, (char*)EndlessNames[language], 0x0001);
+    }
+    else{
+        ST7735_FillRect(42, 80, 44, 21, 0xbebf);    // menu background
+        ST7735_DrawBitmap(44, 100, Charts[chartIndex].title[language], 40, 20);
+    }
 }
 
-////////////////////////////////////////////////////////////////////////////////////
+void drawGradeCounts(){
+    for(int g = Perfect; g >= Miss; g--){
+        ST7735_DrawString(1, 11 + Perfect - g, (char*)GradeNames[language][g], 0x0001);
+        ST7735_SetCursor(11, 11 + Perfect - g);
+        ST7735_OutUDec(judge.getCount((Grade)g), 0x0001);
+    }
+}
 
 int mainchina(void){    //mainchina
     //char l;
   __disable_irq();
   PLL_Init(); // set bus speed
   LaunchPad_Init();
-  DAC5_Init();
-  Sound_Init(1,1);
+  Sound_Init(SOUND_PERIOD,1);
   ST7735_InitPrintf();
   ST7735_FillScreen(0xFFFF);
   __enable_irq();
 
   while(1){
-      Sound_Start(9956);
-      Clock_Delay1ms(1000);
+      uint32_t note = Sound_Note(60);
+      Clock_Delay1ms(500);
+      Sound_Release(note);
+      Clock_Delay1ms(500);
 //      Clock_Delay(Tchinesems);
 //      Sound_Stop();
 //      Clock_Delay(Tchinesems);
@@ -892,27 +786,22 @@ int mainchina(void){    //mainchina
   }
 }
 
-// use main1 to observe special characters
-int main(void){ // main1
-    char l;
+// Everything main sets up before interrupts are enabled
+void gameInit(void){
   __disable_irq();
   PLL_Init(); // set bus speed
   LaunchPad_Init();
-  DAC5_Init();
-  Sound_Init(1,1);
+  Sound_Init(SOUND_PERIOD,1);
   Sensor.Init();
   ST7735_InitPrintf();
   ST7735_FillScreen(0xFFFF);            // set screen to black
+  UART_Init();                          // the debug reports and the Recorder print on it, see UARTOut.h
 
-//  SysTick->LOAD = 0xFFFFFF;    // max
-//  SysTick->VAL = 0;            // any write to current clears it
-//  SysTick->CTRL = 0x00000005;  // enable SysTick with core clock
-//
-//  startTime = SysTick->VAL;
-//  stopTime = SysTick->VAL;
-//  Offset = (startTime-stopTime)&0x0FFFFFF; // in bus cycles
-
-  TimerG12_IntArm(80000000/30,1);
+  M = Recorder_Init(M);
+  LcdStats_Init();
+  LoadMeter_Init();
+  GameClock_Init(1);
+  Profile_Init();
   //TimerG0_IntArm(40000000/30000, 1000 ,2);
 //  TimerG6_IntArm(2667, 1,2);
   TimerG6_IntArm(20000,1,2);
@@ -937,142 +826,114 @@ int main(void){ // main1
 //  ST7735_DrawBitmap(32, 50, white_key, 32, 30);
 //  ST7735_DrawBitmap(64, 50, black_key, 32, 30);
 //  ST7735_DrawBitmap(96, 50, white_key, 32, 30);
-  generateRowArray();
   __enable_irq();
+}
 
-  while(1){
-
-      if(FSM[stateIndex].mode == 0){
-          if(switchingToMenu || startingGame){
-              startingGame = false;
-              switchingToMenu = false;
-              uint32_t curstate = stateIndex;
-
-              song = song1;
-              rowArray = rowArray1;
-              songLength = songLength1;
-
-              ST7735_FillScreen(0xbebf);            // set screen to white
-              //ST7735_FillScreen(0xFFFF);
-              //clear whole screen, draw necessary sprites
-              ST7735_DrawBitmap(11, 30, Sprite::PianoTilesTitle, 106, 20);
-              ST7735_DrawBitmap(44, 145, Sprite::PlayButton, 40, 20);
-
-
-              if(curstate == 0){
-                  ST7735_DrawBitmap(44, 65, Sprite::EnglishButton, 40, 20);
-                  ST7735_DrawBitmap(44, 100, Sprite::Song1English, 40, 20);
-
-              }
-              if(curstate == 1){
-                  ST7735_DrawBitmap(44, 65, Sprite::SpanishButton, 40, 20);
-                  ST7735_DrawBitmap(44, 100, Sprite::Song1Spanish, 40, 20);
-              }
-              if(curstate == 2){
-                  ST7735_DrawBitmap(44, 65, Sprite::EnglishButton, 40, 20);
-                  ST7735_DrawBitmap(44, 100, Sprite::Song2English, 40, 20);
-              }
-              if(curstate == 3){
-                  ST7735_DrawBitmap(44, 65, Sprite::SpanishButton, 40, 20);
-                  ST7735_DrawBitmap(44, 100, Sprite::Song2Spanish, 40, 20);
-              }
+// One pass of the main loop: events from the game ISR, then the screen.
+// The host build in host/ calls this directly.
+void gameLoop(void){
+  LOAD_MAIN();
+  PROFILE_ZONE("loop");
+  Recorder_Dump();
+  Profile_Poll();
+  LoadMeter_Report();
+  GameEvent e;
+  while(gameEvents.pop(&e)){
+      if(e.type == EVENT_MODE){
+          screenMode = e.data;
+          switchingToMenu = (screenMode == MODE_MENU);
+          switchingToGame = (screenMode == MODE_GAME);
+          switchingToEnd = (screenMode == MODE_END);
+          if(switchingToGame){
+              Recorder_Game(chartIndex);
           }
-          else if(switchingMenuState){
-              //replace necessary sprites
-              switchingMenuState = false;
-              uint32_t curstate = stateIndex;
-              if(curstate == 0){
-                  ST7735_DrawBitmap(44, 65, Sprite::EnglishButton, 40, 20);
-                  ST7735_DrawBitmap(44, 100, Sprite::Song1English, 40, 20);
-
-              }
-              if(curstate == 1){
-                  ST7735_DrawBitmap(44, 65, Sprite::SpanishButton, 40, 20);
-                  ST7735_DrawBitmap(44, 100, Sprite::Song1Spanish, 40, 20);
-              }
-              if(curstate == 2){
-                  ST7735_DrawBitmap(44, 65, Sprite::EnglishButton, 40, 20);
-                  ST7735_DrawBitmap(44, 100, Sprite::Song2English, 40, 20);
-              }
-              if(curstate == 3){
-                  ST7735_DrawBitmap(44, 65, Sprite::SpanishButton, 40, 20);
-                  ST7735_DrawBitmap(44, 100, Sprite::Song2Spanish, 40, 20);
+          if(switchingToEnd){
+              uint32_t counts[4];
+              for(int g = Miss; g <= Perfect; g++){
+                  counts[g] = judge.getCount((Grade)g);
               }
+              Recorder_Result(score, counts);
+              Profile_Dump();
+              LoadMeter_Dump();
           }
       }
-      else if(FSM[stateIndex].mode == 1){ //initialize if switching mode, otherwise redraw keys
-          if(switchingToGame){
-              switchingToGame = false;
-              startGameRows();
-              ST7735_DrawBitmap(0, 160, Sprite::BottomBlock, 128, 20);
-              ST7735_DrawBitmap(0, 20, Sprite::TopBlock, 128, 20);
+      else if(e.type == EVENT_MENU){
+          switchingMenuState = true;
+      }
+      else if(e.type == EVENT_JUDGED){
+          lastGrade = (Grade)e.data;
+          gradeChanged = true;
+      }
+  }
 
+  if(screenMode == MODE_MENU){
+      PROFILE_ZONE("menu");
+      if(switchingToMenu || startingGame){
+          startingGame = false;
+          switchingToMenu = false;
+
+          ST7735_FillScreen(0xbebf);            // set screen to white
+          //ST7735_FillScreen(0xFFFF);
+          //clear whole screen, draw necessary sprites
+          ST7735_DrawBitmap(11, 30, Sprite::PianoTilesTitle, 106, 20);
+          ST7735_DrawBitmap(44, 145, Sprite::PlayButton, 40, 20);
+          drawMenu();
+      }
+      else if(switchingMenuState){
+          //replace necessary sprites
+          switchingMenuState = false;
+          drawMenu();
+      }
+  }
+  else if(screenMode == MODE_GAME){ //initialize if switching mode, otherwise redraw keys
+      PROFILE_ZONE("game");
+      if(switchingToGame){
+          switchingToGame = false;
+          ST7735_FillScreen(0xFFFF);            // set screen to white to reset screen
+          for(uint16_t i = bottomRow; i != (uint16_t)(topRow + 1); i++){
+              ROW(i).drawRow();
           }
-          else{
-              //print score
-              ST7735_SetCursor(1,1);
-              if(language == 0){
-                  //ST7735_OutString((char*) "chinesee");
-                  //char stringeesh[] = "lameesh";
-                  ST7735_DrawString(1, 1, "Score:", 0x0000);
-                  ST7735_SetCursor(7,1);
-                  ST7735_OutUDec(score/songLength, 0x0000);
-                  //printf("Score = %u %%", score/songLength);
-              }
-              else{
-                  ST7735_DrawString(1, 1, "Calificar:", 0x0000);
-                  ST7735_SetCursor(11,1);
-                  ST7735_OutUDec(score/songLength, 0x0000);
-                  //printf("Calificar = %u %%", score/songLength);
-              }
-              //printf("SAC=%3u,Center=%4u",SAC,Center);
-
-              for(int i = bottomRow; i <= topRow; i++){
-                  for(int j = 0; j < 4; j++){
-                      rowArray[i].getKey(j).redrawKey();
-                  }
-                  if(i == bottomRow){
-                      //ST7735_DrawBitmap(0, 160, Sprite::BottomBlock, 128, 20);
-                  }
-                  if(i == topRow){
-                     // ST7735_DrawBitmap(0, 20, Sprite::TopBlock, 128, 20);
-                  }
-
-              }
-              for(int i = 3; i > 0; i--){
-                  if(lives < i){
-                      ST7735_DrawBitmap(128 - i * 10, 10, Sprite::EmptyHeart, 8, 8);
-                  }
-                  else{
-                      ST7735_DrawBitmap(128 - i * 10, 10, Sprite::Heart, 8, 8);
-                  }
-              }
+          ST7735_DrawBitmap(0, 160, Sprite::BottomBlock, 128, 20);
+          ST7735_DrawBitmap(0, 20, Sprite::TopBlock, 128, 20);
 
-              adjustVisible();
-          }
       }
-      else if(FSM[stateIndex].mode == 2){ //always try to redraw key and adjust
-          //switchingMode = false;
-          for(int i = bottomRow; i <= topRow; i++){
-              for(int j = 0; j < 4; j++){
-                  rowArray[i].getKey(j).redrawKey();
-              }
-
-          }
+      else{
+          //print score
           ST7735_SetCursor(1,1);
           if(language == 0){
-              ST7735_DrawString(1, 1, "Score:", 0x0000);
+              //ST7735_OutString((char*) "chinesee");
+              //char stringeesh[] = "lameesh";
+              ST7735_DrawString(1, 1, (char*)"Score:", 0x0000);
               ST7735_SetCursor(7,1);
-              ST7735_OutUDec(score/songLength, 0x0000);
+              ST7735_OutUDec(shownScore(), 0x0000);
+              //printf("Score = %u %%", score/songLength);
           }
           else{
-              ST7735_DrawString(1, 1, "Calificar:", 0x0000);
+              ST7735_DrawString(1, 1, (char*)"Calificar:", 0x0000);
               ST7735_SetCursor(11,1);
-              ST7735_OutUDec(score/songLength, 0x0000);
+              ST7735_OutUDec(shownScore(), 0x0000);
+              //printf("Calificar = %u %%", score/songLength);
+          }
+          //printf("SAC=%3u,Center=%4u",SAC,Center);
+          if(gradeChanged){
+              gradeChanged = false;
+              ST7735_DrawString(1, 14, (char*)"        ", 0x0000);
+              ST7735_DrawString(1, 14, (char*)GradeNames[language][lastGrade], 0x0000);
+          }
+
+          for(uint16_t i = bottomRow; i != (uint16_t)(topRow + 1); i++){
+              for(int j = 0; j < 4; j++){
+                  ROW(i).getKey(j).redrawKey();
+              }
+              if(i == bottomRow){
+                  //ST7735_DrawBitmap(0, 160, Sprite::BottomBlock, 128, 20);
+              }
+              if(i == topRow){
+                 // ST7735_DrawBitmap(0, 20, Sprite::TopBlock, 128, 20);
+              }
+
           }
-          //ST7735_DrawBitmap(0, 20, Sprite::TopBlock, 128, 20);
-          //ST7735_DrawBitmap(0, 160, Sprite::BottomBlock, 128, 20);
-          for(int i = 3; i > 0; i--){
+          for(uint32_t i = 3; i > 0; i--){
               if(lives < i){
                   ST7735_DrawBitmap(128 - i * 10, 10, Sprite::EmptyHeart, 8, 8);
               }
@@ -1080,52 +941,61 @@ int main(void){ // main1
                   ST7735_DrawBitmap(128 - i * 10, 10, Sprite::Heart, 8, 8);
               }
           }
+
           adjustVisible();
       }
-      else if(FSM[stateIndex].mode == 3){
-          if(switchingToEnd){
-              switchingToEnd = false;
-              uint32_t curstate = stateIndex;
-              ST7735_FillScreen(0xFFFF);            // set screen to white
-              ST7735_SetCursor(1,1);
-
-              if(curstate == 4 || curstate == 5){
-                  //char str[] = "You lose";
-                  if(language == 0){
-                      ST7735_DrawBitmap(24, 100, Sprite::YouLoseEnglish, 80, 40);
-                      ST7735_DrawString(1, 1, "Score:", 0x0001);
-                      ST7735_SetCursor(7,1);
-                      ST7735_OutUDec(score/songLength, 0x0001);
-                  }
-                  else{
-                      ST7735_DrawBitmap(24, 100, Sprite::YouLoseSpanish, 80, 40);
-                      ST7735_DrawString(1, 1, "Calificar:", 0x0001);
-                      ST7735_SetCursor(11,1);
-                      ST7735_OutUDec(score/songLength, 0x0001);
-                  }
+  }
+  else if(screenMode == MODE_END){
+      PROFILE_ZONE("end");
+      if(switchingToEnd){
+          switchingToEnd = false;
+          ST7735_FillScreen(0xFFFF);            // set screen to white
+          ST7735_SetCursor(1,1);
 
+          if(!won){
+              //char str[] = "You lose";
+              if(language == 0){
+                  ST7735_DrawBitmap(24, 100, Sprite::YouLoseEnglish, 80, 40);
+                  ST7735_DrawString(1, 1, (char*)"Score:", 0x0001);
+                  ST7735_SetCursor(7,1);
+                  ST7735_OutUDec(shownScore(), 0x0001);
+              }
+              else{
+                  ST7735_DrawBitmap(24, 100, Sprite::YouLoseSpanish, 80, 40);
+                  ST7735_DrawString(1, 1, (char*)"Calificar:", 0x0001);
+                  ST7735_SetCursor(11,1);
+                  ST7735_OutUDec(shownScore(), 0x0001);
+              }
+
+          }
+          else{
+              if(language == 0){
+                  ST7735_DrawBitmap(24, 100, Sprite::YouWinEnglish, 80, 40);
+                  ST7735_DrawString(1, 1, (char*)"Score:", 0x0001);
+                  ST7735_SetCursor(7,1);
+                  ST7735_OutUDec(shownScore(), 0x0001);
               }
               else{
-                  if(language == 0){
-                      ST7735_DrawBitmap(24, 100, Sprite::YouWinEnglish, 80, 40);
-                      ST7735_DrawString(1, 1, "Score:", 0x0001);
-                      ST7735_SetCursor(7,1);
-                      ST7735_OutUDec(score/songLength, 0x0001);
-                  }
-                  else{
-                      ST7735_DrawBitmap(24, 100, Sprite::YouWinSpanish, 80, 40);
-                      ST7735_DrawString(1, 1, "Calificar:", 0x0001);
-                      ST7735_SetCursor(11,1);
-                      ST7735_OutUDec(score/songLength, 0x0001);
-                  }
-                  //char str[] = "You win";
-                  //ST7735_DrawBitmap(50, 50, Sprite::EmptyHeart, 8, 8);
+                  ST7735_DrawBitmap(24, 100, Sprite::YouWinSpanish, 80, 40);
+                  ST7735_DrawString(1, 1, (char*)"Calificar:", 0x0001);
+                  ST7735_SetCursor(11,1);
+                  ST7735_OutUDec(shownScore(), 0x0001);
               }
-              //clear whole screen, draw necessary sprites
+              //char str[] = "You win";
+              //ST7735_DrawBitmap(50, 50, Sprite::EmptyHeart, 8, 8);
           }
+          drawGradeCounts();
+          //clear whole screen, draw necessary sprites
       }
+  }
+  LcdStats_Report();
+}
 
-
+// use main1 to observe special characters
+int main(void){ // main1
+  gameInit();
+  while(1){
+      gameLoop();
   }
 
 
@@ -0,0 +1,116 @@
+// LcdStats.cpp
+// Runs on MSPM0G3507
+// LCD traffic per game frame, see LcdStats.h
+
+#include <stdint.h>
+#include <ti/devices/msp/msp.h>
+#include "LcdStats.h"
+#include "GameClock.h"
+#include "SmallFont.h"
+#include "../inc/SPI.h"
+#include "../inc/ST7735.h"
+#include "UARTOut.h"
+
+static LcdFrame Total;      // running counts at the last latch
+static LcdFrame Last;       // the frame before the last latch
+static volatile uint32_t LastFrame; // frame number of Last, stored after it
+static uint32_t Peak, PeriodPeak;
+static uint32_t Reported, Overlaid;     // main loop, last frame shown
+
+static void take(uint32_t count, uint32_t *total, uint32_t *frame){
+    *frame = count - *total;    // the counts wrap, the difference doesn't
+    *total = count;
+}
+
+void LcdStats_Init(void){
+    Total.commands = SPI_CommandCount;
+    Total.data = SPI_DataCount;
+    Total.windows = ST7735_WindowCount;
+    for(int i = 0; i < ST7735_DRAWS; i++){
+        Total.draws[i] = ST7735_DrawCount[i];
+    }
+    Reported = Overlaid = GameClock_Frames();
+}
+
+// Only the main loop draws, and the ISR only reads its counters,
+// so the main loop never has to stop the ISR to count
+void LcdStats_Latch(void){
+    take(SPI_CommandCount, &Total.commands, &Last.commands);
+    take(SPI_DataCount, &Total.data, &Last.data);
+    take(ST7735_WindowCount, &Total.windows, &Last.windows);
+    for(int i = 0; i < ST7735_DRAWS; i++){
+        take(ST7735_DrawCount[i], &Total.draws[i], &Last.draws[i]);
+    }
+    if(Last.data > Peak){
+        Peak = Last.data;
+    }
+    uint32_t frames = GameClock_Frames();
+    if(frames%LCDSTATS_PERIOD == 0){
+        PeriodPeak = Peak;
+        Peak = 0;
+    }
+    __DMB();
+    LastFrame = frames - 1;
+}
+
+uint32_t LcdStats_Frame(LcdFrame *f){uint32_t frame;
+    do{
+        frame = LastFrame;
+        __DMB();
+        *f = Last;
+        __DMB();
+    }while(frame != LastFrame); // latched in between, read again
+    return frame;
+}
+
+uint32_t LcdStats_Peak(void){
+    return PeriodPeak;
+}
+
+static void outCount(const char *name, uint32_t n){
+    UARTOut_String(name);
+    UARTOut_UDec(n);
+}
+
+// // lcd 1234 cmd 9 data 20154 win 350 px 310 hl 0 vl 0 rect 12 bmp 8 chr 20 circ 0 peak 81304
+static void sendReport(uint32_t frame, const LcdFrame &f){
+    outCount("// lcd ", frame);
+    outCount(" cmd ", f.commands);
+    outCount(" data ", f.data);
+    outCount(" win ", f.windows);
+    outCount(" px ", f.draws[ST7735_DRAW_PIXEL]);
+    outCount(" hl ", f.draws[ST7735_DRAW_HLINE]);
+    outCount(" vl ", f.draws[ST7735_DRAW_VLINE]);
+    outCount(" rect ", f.draws[ST7735_DRAW_RECT]);
+    outCount(" bmp ", f.draws[ST7735_DRAW_BITMAP]);
+    outCount(" chr ", f.draws[ST7735_DRAW_CHAR]);
+    outCount(" circ ", f.draws[ST7735_DRAW_CIRCLE]);
+    outCount(" peak ", LcdStats_Peak());
+    UARTOut_String("\r\n");
+}
+
+static void drawOverlay(const LcdFrame &f){
+    uint32_t draws = 0;
+    for(int i = 0; i < ST7735_DRAWS; i++){
+        draws += f.draws[i];
+    }
+    SmallFont_OutVertical(f.data/10, 2, 159);
+    SmallFont_OutVertical(f.windows, 26, 159);
+    SmallFont_OutVertical(draws, 50, 159);
+}
+
+void LcdStats_Report(void){
+    if(!LCDSTATS_UART && !LCDSTATS_OVERLAY){
+        return;
+    }
+    LcdFrame f;
+    uint32_t frame = LcdStats_Frame(&f);
+    if(LCDSTATS_UART && frame - Reported >= LCDSTATS_PERIOD){
+        Reported = frame;
+        sendReport(frame, f);
+    }
+    if(LCDSTATS_OVERLAY && frame != Overlaid){
+        Overlaid = frame;
+        drawOverlay(f);
+    }
+}
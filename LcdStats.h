@@ -0,0 +1,45 @@
+// LcdStats.h
+// Runs on MSPM0G3507
+// LCD traffic per game frame. SPI.cpp counts command and data bytes and
+// ST7735.cpp counts address windows and draw calls by primitive. The game
+// ISR latches the counts at every TIMG12 frame, so the main loop reads
+// what the last whole frame sent, whatever it was drawing at the time.
+//
+// LCDSTATS_UART prints a line over UART0 every LCDSTATS_PERIOD frames, as
+// a // comment (see UARTOut.h); a line is about 100 characters, 9ms of
+// busy-wait once a second. LCDSTATS_OVERLAY draws the last frame's data bytes in
+// tens, its windows and its draw calls along the bottom of the screen.
+// The overlay is about 850 bytes itself, counted in the frame after.
+
+#ifndef LCDSTATS_H_
+#define LCDSTATS_H_
+#include <stdint.h>
+#include "../inc/ST7735.h"
+
+#define LCDSTATS_UART    0
+#define LCDSTATS_OVERLAY 0
+#define LCDSTATS_PERIOD 30  // frames between UART reports, one a second
+
+struct LcdFrame {
+    uint32_t commands;      // command bytes
+    uint32_t data;          // data bytes, pixels are 2 each
+    uint32_t windows;       // address windows set
+    uint32_t draws[ST7735_DRAWS];   // calls of each primitive
+};
+
+// Starts counting from here, call once the screen is set up
+void LcdStats_Init(void);
+
+// Game ISR, once a frame after GameClock_Tick
+void LcdStats_Latch(void);
+
+// Last whole frame, returns its GameClock frame number
+uint32_t LcdStats_Frame(LcdFrame *f);
+
+// Most data bytes in one frame since the last UART report
+uint32_t LcdStats_Peak(void);
+
+// Main loop: sends the UART report and draws the overlay when they are on
+void LcdStats_Report(void);
+
+#endif /* LCDSTATS_H_ */
@@ -0,0 +1,168 @@
+// LoadMeter.cpp
+// Runs on MSPM0G3507
+// CPU load and ISR latency, see LoadMeter.h
+
+#include <stdint.h>
+#include <ti/devices/msp/msp.h>
+#include "LoadMeter.h"
+#include "GameClock.h"
+#include "Sound.h"
+#include "../inc/LaunchPad.h"
+#include "../inc/SPI.h"
+#include "../inc/TExaS.h"
+#include "UARTOut.h"
+
+#define SECOND_FRAMES 30
+
+static uint32_t Total[LOAD_SOURCES];    // running cycles, they wrap
+static uint32_t Latched[LOAD_SOURCES];  // Total at the last latch
+static LoadSecond Last;
+static volatile uint32_t Seconds;   // stored after Last
+static uint32_t Inner;          // cycles of the ISRs inside the running scope so far
+static uint32_t Histogram[LOAD_ISRS][LOAD_BUCKETS];
+static uint32_t MaxLatency[LOAD_ISRS];
+static uint32_t Reported;       // main loop, last second printed
+static const uint32_t Pins[LOAD_ISRS] = {GREEN, BLUE, RED, 0};  // PB27, PB22, PB26
+static const char * const Names[LOAD_SOURCES] = {"tg12", "tg6", "systick", "render", "draw", "idle"};
+
+// The ISRs time themselves with TIMG12 alone, one register read. It
+// counts down and reloads every frame, and no ISR takes a frame.
+LoadScope::LoadScope(uint32_t source, uint32_t latency) : source(source), lcdBytes(0){
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    start = TIMG12->COUNTERREGS.CTR;
+    inner = Inner;
+    Inner = 0;
+    __set_PRIMASK(primask);
+    GPIOB->DOUTSET31_0 = Pins[source];
+    uint32_t bucket = 0;
+    for(uint32_t limit = 32; latency >= limit && bucket < LOAD_BUCKETS-1; limit <<= 1){
+        bucket++;
+    }
+    Histogram[source][bucket]++;
+    if(latency > MaxLatency[source]){
+        MaxLatency[source] = latency;
+    }
+}
+
+// A main loop pass can take several frames, so it needs the whole clock
+LoadScope::LoadScope() : source(LOAD_DRAW), inner(0){
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    lcdBytes = SPI_CommandCount + SPI_DataCount;
+    start = GameClock_Now();
+    Inner = 0;      // ISRs between passes don't count against this one
+    __set_PRIMASK(primask);
+}
+
+LoadScope::~LoadScope(){uint32_t elapsed;
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if(source < LOAD_ISRS){
+        GPIOB->DOUTCLR31_0 = Pins[source];
+        elapsed = start - TIMG12->COUNTERREGS.CTR;
+        if((int32_t)elapsed < 0){   // TIMG12 reloaded in between
+            elapsed += GAMECLOCK_FRAME;
+        }
+    }
+    else{
+        elapsed = GameClock_Now() - start;
+        if(SPI_CommandCount + SPI_DataCount == lcdBytes){
+            source = LOAD_IDLE;
+        }
+    }
+    Total[source] += elapsed - Inner;   // less the ISRs that preempted this one
+    Inner = inner + elapsed;            // which all counts as preemption of the one before
+    __set_PRIMASK(primask);
+}
+
+void LoadMeter_Init(void){
+    if(LOADMETER_MODE == LOADMETER_TEXAS){
+        TExaS_Init(0, 0, &LoadMeter_Logic);
+    }
+}
+
+void LoadMeter_Latch(void){
+    if(GameClock_Frames()%SECOND_FRAMES){
+        return;
+    }
+    for(int i = 0; i < LOAD_SOURCES; i++){
+        Last.cycles[i] = Total[i] - Latched[i];
+        Latched[i] = Total[i];
+    }
+    __DMB();
+    Seconds = Seconds + 1;
+}
+
+uint32_t LoadMeter_Second(LoadSecond *s){uint32_t seconds;
+    do{
+        seconds = Seconds;
+        __DMB();
+        *s = Last;
+        __DMB();
+    }while(seconds != Seconds); // latched in between, read again
+    return seconds;
+}
+
+void LoadMeter_Latency(uint32_t isr, uint32_t buckets[LOAD_BUCKETS], uint32_t *max){
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    for(int i = 0; i < LOAD_BUCKETS; i++){
+        buckets[i] = Histogram[isr][i];
+    }
+    *max = MaxLatency[isr];
+    __set_PRIMASK(primask);
+}
+
+uint8_t LoadMeter_Logic(void){uint32_t out = GPIOB->DOUT31_0;
+    return 0x80|((out>>22)&0x01)|((out>>25)&0x06);  // PB27 PB26 PB22
+}
+
+// // load tg12 0.4% tg6 3.1% systick 1.0% render 4.2% draw 60.2% idle 31.1%
+void LoadMeter_Report(void){
+    if(LOADMETER_MODE != LOADMETER_UART){
+        return;
+    }
+    LoadSecond s;
+    uint32_t seconds = LoadMeter_Second(&s);
+    if(seconds == Reported){
+        return;
+    }
+    Reported = seconds;
+    UARTOut_String("// load");
+    for(int i = 0; i < LOAD_SOURCES; i++){
+        uint32_t tenths = (uint64_t)s.cycles[i]*1000/GAMECLOCK_HZ;
+        UARTOut_String(" ");
+        UARTOut_String(Names[i]);
+        UARTOut_String(" ");
+        UARTOut_UDec(tenths/10);
+        UARTOut_String(".");
+        UARTOut_UDec(tenths%10);
+        UARTOut_String("%");
+    }
+    UARTOut_String("\r\n");
+}
+
+// // latency tg6 max 412 cycles: 1234 10 0 0 0 0 0 0 0 0
+void LoadMeter_Dump(void){
+    if(LOADMETER_MODE != LOADMETER_UART){
+        return;
+    }
+    for(int i = 0; i < LOAD_ISRS; i++){
+        uint32_t buckets[LOAD_BUCKETS], max;
+        LoadMeter_Latency(i, buckets, &max);
+        UARTOut_String("// latency ");
+        UARTOut_String(Names[i]);
+        UARTOut_String(" max ");
+        UARTOut_UDec(max);
+        UARTOut_String(" cycles:");
+        for(int b = 0; b < LOAD_BUCKETS; b++){
+            UARTOut_String(" ");
+            UARTOut_UDec(buckets[b]);
+        }
+        UARTOut_String("\r\n");
+    }
+    UARTOut_String("// audio underruns ");
+    UARTOut_UDec(Sound_Underruns());
+    UARTOut_String("\r\n");
+}
@@ -0,0 +1,96 @@
+// LoadMeter.h
+// Runs on MSPM0G3507
+// CPU load per second and ISR latency. Each ISR holds a LOAD_ISR scope,
+// which times the ISR less the ISRs that preempt it and logs how long
+// after its timer event it started. gameLoop holds a LOAD_MAIN scope, a
+// pass that sends nothing to the LCD counts as idle. The game ISR latches
+// the six totals every 30 frames, exactly one second. Time counts in the
+// second its scope ends in, so a long screen fill can push one over 100%.
+//
+// LOADMETER_UART prints the load over UART0 once a second, and the
+// latency histograms at the end of each game, all as // comments (see
+// UARTOut.h). The load line takes about 5ms of the idle time it reports.
+// LOADMETER_TEXAS instead drives the TExaS logic analyzer with
+// LoadMeter_Logic: bit 0 is TIMG6 (PB22 blue), bit 1 SysTick (PB26 red)
+// and bit 2 TIMG12 (PB27 green). The pins are high while each ISR runs
+// in both modes, PendSV has no pin.
+// TExaS takes over UART0 and adds its own 10kHz TIMG7 ISR.
+//
+// An ISR scope costs about 50 cycles, a main loop pass about 100.
+
+#ifndef LOADMETER_H_
+#define LOADMETER_H_
+#include <stdint.h>
+
+#define LOADMETER_OFF   0
+#define LOADMETER_UART  1
+#define LOADMETER_TEXAS 2
+
+#define LOADMETER_MODE LOADMETER_OFF
+
+// What the CPU was doing
+#define LOAD_TIMG12  0
+#define LOAD_TIMG6   1
+#define LOAD_SYSTICK 2
+#define LOAD_RENDER  3      // PendSV rendering audio, latency from when SysTick pended it
+#define LOAD_DRAW    4      // main loop passes that sent to the LCD
+#define LOAD_IDLE    5      // main loop passes that didn't
+#define LOAD_SOURCES 6
+#define LOAD_ISRS    4      // the sources that are ISRs
+
+// Latency histogram, bucket 0 is under 32 cycles (0.4us) and each next
+// one twice as wide, the last holds everything from 8192 cycles (102us)
+#define LOAD_BUCKETS 10
+
+// Cycles spent in each source over the last whole second, they add up
+// to GAMECLOCK_HZ give or take the time outside gameLoop
+struct LoadSecond {
+    uint32_t cycles[LOAD_SOURCES];
+};
+
+// Bookkeeping of one ISR or main loop pass, on its stack
+class LoadScope{
+public:
+    LoadScope(uint32_t source, uint32_t latency);   // ISR, latency in cycles
+    LoadScope();                                    // main loop pass
+    ~LoadScope();
+private:
+    uint32_t source;
+    uint32_t start;
+    uint32_t inner;     // cycles of the ISRs that preempted the one before
+    uint32_t lcdBytes;  // main loop, SPI bytes before the pass
+};
+
+#define LOAD_CAT2(a, b) a##b
+#define LOAD_CAT(a, b) LOAD_CAT2(a, b)
+
+#if LOADMETER_MODE != LOADMETER_OFF
+#define LOAD_ISR(source, latency) LoadScope LOAD_CAT(loadScope, __LINE__)(source, latency)
+#define LOAD_MAIN() LoadScope LOAD_CAT(loadScope, __LINE__)
+#else
+#define LOAD_ISR(source, latency)
+#define LOAD_MAIN()
+#endif
+
+// Starts the TExaS logic analyzer in that mode, call before interrupts
+void LoadMeter_Init(void);
+
+// Game ISR, once a frame after GameClock_Tick
+void LoadMeter_Latch(void);
+
+// Last whole second, returns how many seconds have been latched
+uint32_t LoadMeter_Second(LoadSecond *s);
+
+// Latency histogram of an ISR since reset, and the longest latency
+void LoadMeter_Latency(uint32_t isr, uint32_t buckets[LOAD_BUCKETS], uint32_t *max);
+
+// TExaS logic analyzer function, the three ISR pins
+uint8_t LoadMeter_Logic(void);
+
+// Main loop: prints the last second over UART once
+void LoadMeter_Report(void);
+
+// Main loop: prints the latency histograms over UART
+void LoadMeter_Dump(void);
+
+#endif /* LOADMETER_H_ */
@@ -0,0 +1,39 @@
+// PWM8.cpp
+// Runs on MSPM0G3507
+// 8-bit PWM audio on PB4, see PWM8.h
+
+#include <stdint.h>
+#include <ti/devices/msp/msp.h>
+#include "PWM8.h"
+#include "../inc/Clock.h"
+
+#define PB4INDEX  16 // UART1_TX  UART3_CTS TIMA1_C0  TIMA0_C2  TIMA1_C0N
+
+void PWM8_Init(void){
+    TIMA1->GPRCM.RSTCTL = (uint32_t)0xB1000003;
+    TIMA1->GPRCM.PWREN = (uint32_t)0x26000001;
+    Clock_Delay(2); // time for TimerA1 to power up
+    IOMUX->SECCFG.PINCM[PB4INDEX] = 0x00000084; // TIMA1 output CCP0
+    TIMA1->CLKSEL = 0x08;   // bus clock
+    TIMA1->CLKDIV = 0x00;   // divide by 1
+    TIMA1->COMMONREGS.CPS = 0;
+    TIMA1->COUNTERREGS.LOAD = 255;  // 256 counts, 312.5kHz
+    TIMA1->COUNTERREGS.CTRCTL = 0x02;
+    // bits 5-4 CM =0, down
+    // bits 3-1 REPEAT =001, continue
+    TIMA1->COUNTERREGS.CCCTL_01[0] = 0; // compare, no capture
+    TIMA1->CPU_INT.IMASK = 0x00;        // no interrupts
+    TIMA1->COMMONREGS.CCPD = 0x01;      // output CCP0
+    TIMA1->COMMONREGS.CCLKCTL = 1;
+    TIMA1->COUNTERREGS.OCTL_01[0] = 0x0000; // connected to PWM
+    TIMA1->COUNTERREGS.CCACT_01[0] = 0x0088;
+    // bits 7-6 CDACT 10 for make low on compare event down
+    // bits 4-3 LACT 01 for make high on load event
+    PWM8_Out(128);
+    TIMA1->COUNTERREGS.CTRCTL |= 0x01;
+}
+
+// High from the load at 255 until the count passes CC going down
+void PWM8_Out(uint32_t data){
+    TIMA1->COUNTERREGS.CC_01[0] = 255 - data;
+}
@@ -0,0 +1,23 @@
+// PWM8.h
+// Runs on MSPM0G3507
+// 8-bit PWM audio on PB4, TIMA1 CCP0, the alternative to the 5-bit DAC
+// that Sound.h selects with SOUND_OUTPUT. TIMA1 counts the 80MHz bus
+// clock down from 255, so the carrier is 312.5kHz, far above what the
+// speaker amp passes; the PB4 resistor of the DAC5 ladder and the amp
+// input filter it. PB0-PB3 are left as inputs, so the rest of the
+// ladder doesn't pull the output down.
+//
+// PWM8_Out is one register write; the timer then holds the level with
+// no more CPU until the next sample.
+
+#ifndef PWM8_H_
+#define PWM8_H_
+#include <stdint.h>
+
+// Starts TIMA1 on PB4 at the middle level, called once
+void PWM8_Init(void);
+
+// Input: data is 0 (always low) to 255 (high all but 1/256)
+void PWM8_Out(uint32_t data);
+
+#endif /* PWM8_H_ */
@@ -0,0 +1,84 @@
+// Profile.cpp
+// Runs on MSPM0G3507
+// Profiling zones, see Profile.h
+
+#include <stdint.h>
+#include <ti/devices/msp/msp.h>
+#include "Profile.h"
+#include "GameClock.h"
+#include "../inc/UART.h"
+#include "UARTOut.h"
+
+volatile bool ProfileRequest = false;
+static ProfileZone *Zones;      // most recently linked first
+static uint32_t Offset;         // cycles of one GameClock_Now, taken off every run
+
+void Profile_Init(void){
+    Offset = 0xFFFFFFFF;
+    for(int i = 0; i < 8; i++){     // shortest of a few, in case an interrupt lands between
+        uint32_t start = GameClock_Now();
+        uint32_t stop = GameClock_Now();
+        if(stop - start < Offset){
+            Offset = stop - start;
+        }
+    }
+}
+
+void Profile_Add(ProfileZone &zone, uint32_t start, uint32_t stop){
+    uint32_t cycles = stop - start;
+    cycles = (cycles > Offset) ? cycles - Offset : 0;
+    zone.count++;
+    zone.total += cycles;
+    if(cycles < zone.min){
+        zone.min = cycles;
+    }
+    if(cycles > zone.max){
+        zone.max = cycles;
+    }
+    if(!zone.linked){   // once per zone, masked so an ISR can't link its own in between
+        uint32_t primask = __get_PRIMASK();
+        __disable_irq();
+        zone.linked = true;
+        zone.next = Zones;
+        Zones = &zone;
+        __set_PRIMASK(primask);
+    }
+}
+
+void Profile_Dump(void){
+    if(!PROFILE){
+        return;
+    }
+    UARTOut_String("// zone        count     min     max    mean\r\n");
+    for(ProfileZone *z = Zones; z; z = z->next){
+        uint32_t primask = __get_PRIMASK();
+        __disable_irq();
+        ProfileZone copy = *z;      // ISRs update theirs at any time
+        z->count = 0;
+        z->total = 0;
+        z->min = 0xFFFFFFFF;
+        z->max = 0;
+        __set_PRIMASK(primask);
+        UARTOut_String("// ");
+        int length = 0;
+        for(const char *pt = copy.name; *pt; pt++){
+            UART_OutChar(*pt);
+            length++;
+        }
+        for(; length < 10; length++){
+            UART_OutChar(' ');
+        }
+        UARTOut_UDecWidth(copy.count, 7);
+        UARTOut_UDecWidth(copy.count ? copy.min : 0, 8);
+        UARTOut_UDecWidth(copy.max, 8);
+        UARTOut_UDecWidth(copy.count ? (uint32_t)(copy.total/copy.count) : 0, 8);
+        UARTOut_String("\r\n");
+    }
+}
+
+void Profile_Poll(void){
+    if(ProfileRequest){
+        ProfileRequest = false;
+        Profile_Dump();
+    }
+}
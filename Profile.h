@@ -0,0 +1,78 @@
+// Profile.h
+// Runs on MSPM0G3507
+// Profiling zones timed with GameClock_Now, which is TIMG12 counting bus
+// cycles (12.5ns) and extended to 32 bits by the frame count.
+//
+//   void TIMG6_IRQHandler(void){
+//       PROFILE_ZONE("TIMG6");
+//       ...
+//   }
+//
+// times everything from the PROFILE_ZONE to the end of its block, and
+// keeps the count, min, max and mean cycles of each zone. A zone in the
+// main loop includes the interrupts that ran inside it; their own zones
+// say how much that was. Profile_Dump sends the table over UART0 as //
+// comments (see UARTOut.h). The main loop dumps at the end of each game,
+// or when ProfileRequest is set from the debugger.
+//
+// With PROFILE 0 the zones compile to nothing. With PROFILE 1 each zone
+// costs about 100 cycles, which shows in the zones around it; the
+// two GameClock_Now reads are measured at init and taken off.
+
+#ifndef PROFILE_H_
+#define PROFILE_H_
+#include <stdint.h>
+#include "GameClock.h"
+
+#define PROFILE 0
+
+struct ProfileZone {
+    const char *name;
+    ProfileZone *next;  // zones linked the first time they finish
+    bool linked;
+    uint32_t count;
+    uint32_t min;       // bus cycles
+    uint32_t max;
+    uint64_t total;
+};
+
+// Adds one run of a zone, called by ProfileScope
+void Profile_Add(ProfileZone &zone, uint32_t start, uint32_t stop);
+
+// Times its own lifetime into a zone
+class ProfileScope{
+public:
+    ProfileScope(ProfileZone &z) : zone(z), start(GameClock_Now()){}
+    ~ProfileScope(){
+        Profile_Add(zone, start, GameClock_Now());
+    }
+private:
+    ProfileZone &zone;
+    uint32_t start;
+};
+
+#define PROFILE_CAT2(a, b) a##b
+#define PROFILE_CAT(a, b) PROFILE_CAT2(a, b)
+
+#if PROFILE
+// A constant initializer, so there is no guard or constructor to run
+#define PROFILE_ZONE(name) \
+    static ProfileZone PROFILE_CAT(profileZone, __LINE__) = {name, 0, false, 0, 0xFFFFFFFF, 0, 0}; \
+    ProfileScope PROFILE_CAT(profileScope, __LINE__)(PROFILE_CAT(profileZone, __LINE__))
+#else
+#define PROFILE_ZONE(name)
+#endif
+
+// Set to dump at the next main loop pass, from the debugger
+extern volatile bool ProfileRequest;
+
+// Measures the cost of the timer reads, call once the GameClock is running
+void Profile_Init(void);
+
+// Sends every zone over UART0 and starts them all again
+void Profile_Dump(void);
+
+// Main loop: dumps if ProfileRequest is set
+void Profile_Poll(void);
+
+#endif /* PROFILE_H_ */
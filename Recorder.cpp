@@ -0,0 +1,96 @@
+// Recorder.cpp
+// Runs on MSPM0G3507
+// Input recorder and replay, see Recorder.h
+
+#include <stdint.h>
+#include "Recorder.h"
+#include "SpscRing.h"
+#include "../inc/UART.h"
+#include "UARTOut.h"
+#include "Replay.h"
+
+SpscRing<RecordEvent, RECORD_EVENTS> Recording;   // input ISR -> main loop
+uint32_t RecordDropped = 0;
+uint32_t ReplayIndex = 0;
+
+uint32_t Recorder_Init(uint32_t seed){
+    if(RECORDER_MODE == RECORDER_REPLAY){
+        UARTOut_String("\r\n// PianoTiles replay\r\n");   // the game results follow, to compare
+        ReplayIndex = 0;
+        return REPLAY_SEED;
+    }
+    if(RECORDER_MODE == RECORDER_CAPTURE){
+        UARTOut_String("\r\n// PianoTiles input capture, paste into Replay.h\r\n#define REPLAY_SEED 0x");
+        UARTOut_UHex(seed);
+        UARTOut_String("\r\nconst RecordEvent ReplayEvents[] = {\r\n");
+    }
+    return seed;
+}
+
+void Recorder_Input(uint8_t type, uint8_t data, uint16_t value, uint32_t time){
+    if(RECORDER_MODE != RECORDER_CAPTURE)
+        return;
+    RecordEvent e = {time, type, data, value};
+    if(!Recording.push(e)){
+        RecordDropped++;
+    }
+}
+
+bool Recorder_Next(RecordEvent *e, uint32_t before){
+    if(RECORDER_MODE != RECORDER_REPLAY)
+        return false;
+    if(ReplayIndex >= sizeof(ReplayEvents)/sizeof(RecordEvent))
+        return false;
+    if((int32_t)(ReplayEvents[ReplayIndex].time - before) >= 0)
+        return false;
+    *e = ReplayEvents[ReplayIndex++];
+    return true;
+}
+
+// One event as an initializer, {0x1234ABCD, 0, 2, 0},
+void Recorder_Dump(void){
+    RecordEvent e;
+    for(int i = 0; i < 4 && Recording.pop(&e); i++){    // bounded so the screen keeps up
+        UARTOut_String("{0x");
+        UARTOut_UHex(e.time);
+        UARTOut_String(", ");
+        if(e.type == RECORD_POT){
+            UARTOut_String("RECORD_POT");
+        }
+        else{
+            UARTOut_UDec(e.type);
+        }
+        UARTOut_String(", ");
+        UARTOut_UDec(e.data);
+        UARTOut_String(", ");
+        UARTOut_UDec(e.value);
+        UARTOut_String("},\r\n");
+    }
+}
+
+void Recorder_Game(uint32_t chart){
+    if(RECORDER_MODE == RECORDER_OFF)
+        return;
+    UARTOut_String("// game chart ");
+    UARTOut_UDec(chart);
+    UARTOut_String("\r\n");
+}
+
+void Recorder_Result(uint32_t score, const uint32_t counts[4]){
+    if(RECORDER_MODE == RECORDER_OFF)
+        return;
+    UARTOut_String("// result score ");
+    UARTOut_UDec(score);
+    UARTOut_String(" miss/good/great/perfect");
+    for(int i = 0; i < 4; i++){
+        UART_OutChar(' ');
+        UARTOut_UDec(counts[i]);
+    }
+    UARTOut_String(" dropped ");
+    UARTOut_UDec(RecordDropped);
+    UARTOut_String("\r\n");
+}
+
+uint32_t Recorder_Dropped(void){
+    return RecordDropped;
+}
@@ -0,0 +1,54 @@
+// Recorder.h
+// Runs on MSPM0G3507
+// Input recorder and replay. Capture logs every timestamped key press,
+// key release and slide pot change, with the random seed, into a RAM ring
+// that the main loop dumps over UART0 as C source (see UARTOut.h).
+// Paste a dump into Replay.h and build with RECORDER_REPLAY to feed the
+// same events back into the input path instead of reading GPIO.
+//
+// The game only uses inputs timestamped before the frame it is running,
+// and judges with frame start times, so a replay makes the same decisions
+// on the same frames as the capture. Two builds replaying one capture can
+// be compared by the game results the replay prints.
+
+#ifndef RECORDER_H_
+#define RECORDER_H_
+#include <stdint.h>
+
+#define RECORDER_OFF     0
+#define RECORDER_CAPTURE 1
+#define RECORDER_REPLAY  2
+
+#define RECORDER_MODE RECORDER_OFF
+
+#define RECORD_EVENTS 256   // capture ring, power of 2, 8 bytes an event
+#define RECORD_POT   0xFF   // type of a slide pot event, value is the 12-bit Reading
+
+struct RecordEvent {
+    uint32_t time;      // GameClock time the input happened
+    uint8_t type;       // input event type, or RECORD_POT
+    uint8_t data;       // lane or key mask
+    uint16_t value;     // slide pot Reading
+};
+
+// Starts a capture or a replay, returns the random seed to run with:
+// the seed given when capturing or off, the recorded seed when replaying
+uint32_t Recorder_Init(uint32_t seed);
+
+// Logs one input, called from the input ISR, does nothing unless capturing
+void Recorder_Input(uint8_t type, uint8_t data, uint16_t value, uint32_t time);
+
+// Next recorded input due before time, false if there isn't one yet
+bool Recorder_Next(RecordEvent *e, uint32_t before);
+
+// Main loop: sends captured inputs over UART0
+void Recorder_Dump(void);
+
+// Main loop: marks the start and result of a game in the dump
+void Recorder_Game(uint32_t chart);
+void Recorder_Result(uint32_t score, const uint32_t counts[4]);
+
+// Inputs lost because the dump fell behind
+uint32_t Recorder_Dropped(void);
+
+#endif /* RECORDER_H_ */
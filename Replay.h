@@ -0,0 +1,10 @@
+// Replay.h
+// Runs on MSPM0G3507
+// Inputs played back when RECORDER_MODE is RECORDER_REPLAY.
+// Replace everything below with a capture dump from UART0 and close the
+// array with }; after the last event.
+
+#define REPLAY_SEED 0x00000001
+const RecordEvent ReplayEvents[] = {
+{0x00000000, RECORD_POT, 0, 2048},
+};
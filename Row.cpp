@@ -36,8 +36,9 @@ Row::Row(){
 
 }
 
-void Row::initializeRow(uint8_t keyColors, int16_t rowY){
-    rowHeight = 30;
+// A row taller than a key bitmap is a hold note
+void Row::initializeRow(uint8_t keyColors, int16_t rowY, uint16_t rowHeight){
+    this->rowHeight = rowHeight;
     onScreen = false;
     this->keyColors = keyColors;
     this->rowY = rowY;
@@ -47,9 +48,9 @@ void Row::initializeRow(uint8_t keyColors, int16_t rowY){
     for(uint8_t i = 0; i < 4; i++){
         uint8_t adjustedVal = (keyColors >> (3 - i)) & 0x01;
         if(adjustedVal == 1)
-            keys[i].initializeKey(i * 32, rowY, 32, 30, Key::black_key);
+            keys[i].initializeKey(i * 32, rowY, 32, rowHeight, Key::black_key);
         else
-            keys[i].initializeKey(i * 32, rowY, 32, 30, Key::white_key);
+            keys[i].initializeKey(i * 32, rowY, 32, rowHeight, Key::white_key);
     }
 }
 
@@ -83,6 +84,14 @@ int16_t Row::getRowY(){
     return rowY;
 }
 
+uint8_t Row::getKeyColors(){
+    return keyColors;
+}
+
+uint16_t Row::getRowHeight(){
+    return rowHeight;
+}
+
 Key& Row::getKey(uint8_t index){
     return keys[index];
 }
@@ -20,7 +20,7 @@ class Row
 public:
     Row(uint8_t keyColors, int16_t rowY);
     Row();
-    void initializeRow(uint8_t keyColors, int16_t rowY);
+    void initializeRow(uint8_t keyColors, int16_t rowY, uint16_t rowHeight = KEY_BITMAP_HEIGHT);
 
     void drawRow();
     void moveRow(int16_t y);
@@ -31,6 +31,8 @@ public:
 
     bool getDisplayState();
     int16_t getRowY();
+    uint8_t getKeyColors();
+    uint16_t getRowHeight();
     Key& getKey(uint8_t index);
 
     virtual ~Row();
@@ -506,6 +506,8 @@ static uint8_t Rotation;           // 0 to 3
 static enum initRFlags TabColor;
 static int16_t _width = ST7735_TFTWIDTH;   // this could probably be a constant, except it is used in Adafruit_GFX and depends on image rotation
 static int16_t _height = ST7735_TFTHEIGHT;
+uint32_t ST7735_DrawCount[ST7735_DRAWS]; // see ST7735.h
+uint32_t ST7735_WindowCount = 0;
 
 
 
@@ -729,6 +731,7 @@ void ST7735_InitR(enum initRFlags option) {
 // (same as Font table is encoded; different from regular bitmap)
 // Requires 11 bytes of transmission
 void static setAddrWindow(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1) {
+  ST7735_WindowCount++;
 
   SPI_OutCommand(ST7735_CASET); // Column addr set
   SPI_OutData(0x00);
@@ -766,6 +769,7 @@ void static pushColor(uint16_t color) {
 //        color 16-bit color, which can be produced by ST7735_Color565()
 // Output: none
 void ST7735_DrawPixel(int16_t x, int16_t y, uint16_t color) {
+  ST7735_DrawCount[ST7735_DRAW_PIXEL]++;
 
   if((x < 0) || (x >= _width) || (y < 0) || (y >= _height)) return;
 
@@ -789,6 +793,7 @@ void ST7735_DrawPixel(int16_t x, int16_t y, uint16_t color) {
 // Output: none
 void ST7735_DrawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
   uint8_t hi = color >> 8, lo = color;
+  ST7735_DrawCount[ST7735_DRAW_VLINE]++;
 
   // Rudimentary clipping
   if((x >= _width) || (y >= _height)) return;
@@ -815,6 +820,7 @@ void ST7735_DrawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
 // Output: none
 void ST7735_DrawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
   uint8_t hi = color >> 8, lo = color;
+  ST7735_DrawCount[ST7735_DRAW_HLINE]++;
 
   // Rudimentary clipping
   if((x >= _width) || (y >= _height)) return;
@@ -852,6 +858,7 @@ void ST7735_FillScreen(uint16_t color) {
 // Output: none
 void ST7735_FillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
   uint8_t hi = color >> 8, lo = color;
+  ST7735_DrawCount[ST7735_DRAW_RECT]++;
 
   // rudimentary clipping (drawChar w/big text requires this)
   if((x >= _width) || (y >= _height)) return;
@@ -888,6 +895,7 @@ int16_t const smallCircle[6][3]={
 void ST7735_DrawSmallCircle(int16_t x, int16_t y, uint16_t color) {
   uint32_t i,w;
   uint8_t hi = color >> 8, lo = color;
+  ST7735_DrawCount[ST7735_DRAW_CIRCLE]++;
   // rudimentary clipping 
   if((x>_width-5)||(y>_height-5)) return; // doesn't fit
   for(i=0; i<6; i++){
@@ -922,6 +930,7 @@ int16_t const circle[10][3]={
 void ST7735_DrawCircle(int16_t x, int16_t y, uint16_t color) {
   uint32_t i,w;
   uint8_t hi = color >> 8, lo = color;
+  ST7735_DrawCount[ST7735_DRAW_CIRCLE]++;
   // rudimentary clipping 
   if((x>_width-9)||(y>_height-9)) return; // doesn't fit
   for(i=0; i<10; i++){
@@ -979,6 +988,7 @@ void ST7735_DrawBitmap(int16_t x, int16_t y, const uint16_t *image, int16_t w, i
   int16_t skipC = 0;                      // non-zero if columns need to be skipped due to clipping
   int16_t originalWidth = w;              // save this value; even if not all columns fit on the screen, the image is still this width in ROM
   int i = w*(h - 1);
+  ST7735_DrawCount[ST7735_DRAW_BITMAP]++;
 
   if((x >= _width) || ((y - h + 1) >= _height) || ((x + w) <= 0) || (y < 0)){
     return;                             // image is totally off the screen, do nothing
@@ -1045,6 +1055,7 @@ void ST7735_DrawBitmap(int16_t x, int16_t y, const uint16_t *image, int16_t w, i
 void ST7735_DrawCharS(int16_t x, int16_t y, char c, int16_t textColor, int16_t bgColor, uint8_t size){
   uint8_t line; // vertical column of pixels of character in font
   int32_t i, j;
+  ST7735_DrawCount[ST7735_DRAW_CHAR]++;
   if((x >= _width)            || // Clip right
      (y >= _height)           || // Clip bottom
      ((x + 6 * size - 1) < 0) || // Clip left
@@ -1092,6 +1103,7 @@ void ST7735_DrawCharS(int16_t x, int16_t y, char c, int16_t textColor, int16_t b
 void ST7735_DrawChar(int16_t x, int16_t y, char c, int16_t textColor, int16_t bgColor, uint8_t size){
   uint8_t line; // horizontal row of pixels of character
   int32_t col, row, i, j;// loop indices
+  ST7735_DrawCount[ST7735_DRAW_CHAR]++;
   if(((x + 6*size - 1) >= _width)  || // Clip right
      ((y + 8*size - 1) >= _height) || // Clip bottom
      ((x + 6*size - 1) < 0)        || // Clip left
@@ -1844,7 +1856,7 @@ int ST7735_open(const char *path, unsigned flags, int llv_fd){
 int ST7735_close( int dev_fd){
     return 0;
 }
-int ST7735_read(int dev_fd, char *buf, unsigned count){char ch;
+int ST7735_read(int dev_fd, char *buf, unsigned count){
 // not implemented
   return 1;
 }
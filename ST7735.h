@@ -222,6 +222,31 @@ enum initRFlags{
  */
 #define ST7735_TFTHEIGHT 160
 
+/**
+ * \brief Primitives counted in ST7735_DrawCount
+ */
+enum ST7735_Draw{
+  ST7735_DRAW_PIXEL,  // ST7735_DrawPixel
+  ST7735_DRAW_HLINE,  // ST7735_DrawFastHLine
+  ST7735_DRAW_VLINE,  // ST7735_DrawFastVLine
+  ST7735_DRAW_RECT,   // ST7735_FillRect, ST7735_FillScreen
+  ST7735_DRAW_BITMAP, // ST7735_DrawBitmap
+  ST7735_DRAW_CHAR,   // ST7735_DrawChar, ST7735_DrawCharS
+  ST7735_DRAW_CIRCLE, // ST7735_DrawCircle, ST7735_DrawSmallCircle
+  ST7735_DRAWS
+};
+
+/**
+ * \brief Calls of each primitive since reset. A primitive that draws with
+ * another counts in both, a size 1 ST7735_DrawCharS is a char and its pixels.
+ */
+extern uint32_t ST7735_DrawCount[ST7735_DRAWS];
+
+/**
+ * \brief Address windows set since reset, 11 bytes each
+ */
+extern uint32_t ST7735_WindowCount;
+
 
 /**
  * \brief The following constants are possible colors for the LCD in RGB format
@@ -40,6 +40,7 @@ uint32_t SlidePot::In(void){
     ADC1->ULLMEM.CTL0 |= 0x00000001;
     ADC1->ULLMEM.CTL1 |= 0x00000100;
     uint32_t volatile delay=ADC1->ULLMEM.STATUS;
+    (void)delay;    // the read is only there to wait
     while((ADC1->ULLMEM.STATUS&0x01) == 0x01) {};
     return ADC1->ULLMEM.MEMRES[0];
 
@@ -1,90 +1,508 @@
 // Sound.cpp
 // Runs on MSPM0
-// Sound assets in sounds/sounds.h
+// Sound assets in sounds/adpcm.h, encoded from sounds/sounds.h
 // Jonathan Valvano
 // 11/15/2021 
 #include <stdint.h>
 #include <ti/devices/msp/msp.h>
 #include "Sound.h"
-#include "sounds/sounds.h"
+#include "sounds/adpcm.h"
+#include "Adpcm.h"
 #include "../inc/DAC5.h"
+#include "PWM8.h"
 #include "../inc/Timer.h"
+#include "GameClock.h"
+#include "LoadMeter.h"
+#include "Profile.h"
 
+// Samples are mixed as signed 8-bit, whatever the output's resolution
+#define OUT_BITS   ((SOUND_OUTPUT == SOUND_PWM) ? 8 : 5)
+#define OUT_MIDDLE (1<<(OUT_BITS-1))
+// The mix times the gain is in steps of 2^-MIX_SHIFT of an output step
+#define MIX_SHIFT  (27 - OUT_BITS)
+// Shaping rounds once, at the output, so the wave keeps all 8 bits
+#define WAVE_BITS  (SOUND_SHAPING ? 8 : OUT_BITS)
 
-//void SysTick_IntArm(uint32_t period, uint32_t priority){
-//  // write this
-//}
-//// initialize a 11kHz SysTick, however no sound should be started
-//// initialize any global variables
-//// Initialize the 5 bit DAC
+// Envelope levels are Q15, 32768 is the wave at full size. They step
+// once every SOUND_CONTROL samples, 1kHz, by amounts worked out here
+// from times in milliseconds.
+#define CONTROL_HZ (SOUND_RATE/SOUND_CONTROL)
+#define FULL 32768
+static constexpr int32_t perStep(int32_t levels, uint32_t ms){
+    return (int32_t)((levels*(int64_t)1000 + CONTROL_HZ*ms/2)/(CONTROL_HZ*ms));
+}
+#define SUSTAIN     (FULL/2)    // a held note settles at half size
+static const int32_t Attack  = perStep(FULL, 5);            // up to full in 5ms
+static const int32_t Decay   = perStep(FULL-SUSTAIN, 150);  // down to SUSTAIN in 150ms
+static const int32_t Release = perStep(FULL, 80);           // down from full in 80ms
+
+enum Stage {WAITING, ATTACK, DECAY, SUSTAINING, RELEASE};
+
+// Slide pot to gain, Q12. Level 0 is silent, and each level up to the
+// top one at 1 is 2.5dB louder, so the pot sounds even along its travel.
+#define VOLUME_LEVELS 16
+struct GainTable {
+    int32_t gain[VOLUME_LEVELS];
+};
+static constexpr GainTable taper(void){
+    GainTable t{};
+    int32_t g = 4096;
+    for(int i = VOLUME_LEVELS-1; i > 0; i--){
+        t.gain[i] = g;
+        g = (g*3 + 2)/4;
+    }
+    return t;
+}
+static constexpr GainTable Gains = taper();
+
+// A wave as output samples less the middle, in 8-bit steps
+template<uint32_t N>
+struct Pcm {
+    int8_t sample[N];
+};
+
+// 8-bit to WAVE_BITS while compiling, so rendering only reads the result
+template<uint32_t N>
+static constexpr Pcm<N> toDac(const uint8_t (&pcm)[N]){
+    Pcm<N> out{};
+    for(uint32_t i = 0; i < N; i++){
+        int32_t level = (pcm[i]*((1<<WAVE_BITS) - 1) + 127)/255;
+        out.sample[i] = (int8_t)((level - (1<<(WAVE_BITS-1)))*(1<<(8 - WAVE_BITS)));
+    }
+    return out;
+}
+
+// 32 samples of a sine, 128 is the middle
+static constexpr uint8_t Sine[32] = {
+  128, 153, 177, 199, 218, 234, 245, 253, 255, 253, 245, 234, 218, 199, 177, 153,
+  128, 103, 79, 57, 38, 22, 11, 3, 1, 3, 11, 22, 38, 57, 79, 103
+};
+static constexpr Pcm<32> Wave = toDac(Sine);
+
+// The assets are at 11.025kHz, the sample position steps by this much
+// (Q16) at SOUND_RATE and reads between two decoded samples
+#define PCM_RATE 11025
+#define PCM_STEP ((((uint32_t)PCM_RATE<<16) + SOUND_RATE/2)/SOUND_RATE)
+
+// A voice is one DDS oscillator with its envelope. Voices[0..Playing-1]
+// are the ones sounding, so PendSV only visits those.
+struct Voice {
+    uint32_t phase;         // top 5 bits index Wave
+    uint32_t increment;     // added to phase every sample
+    int32_t level;          // envelope, Q15
+    uint32_t note;          // from Sound_Note or Sound_Chord, the lowest is the oldest
+    Stage stage;
+    uint32_t start;         // WAITING, the sample it attacks from
+    uint32_t pitch;         // WAITING, its increment from then on
+};
+static Voice Voices[SOUND_VOICES];
+static uint32_t Playing;        // voices sounding
+static const AdpcmAsset *Request;   // sound asset to start, 0 when none
+static const AdpcmAsset *Sample;    // sound asset playing, 0 when none
+static Adpcm Decoder;           // where Sample is up to
+static uint32_t SampleLeft;     // samples still to decode
+static uint32_t SampleFrac;     // Q16 position between S0 and S1
+static int32_t S0, S1;          // decoded samples either side of it
+static uint32_t Notes;          // note numbers given out
+static int32_t Gain;            // from the slide pot, Q12
+static int32_t Shaped;          // rounding error of the last sample, SOUND_SHAPING
+
+// Ping-pong buffer of DAC samples. SysTick plays one half while
+// PendSV renders the other, and hands the half back when it is done.
+#define HALF_EMPTY  0   // SysTick has played it, PendSV is to render it
+#define HALF_FULL   1   // rendered, SysTick is to play it
+#define HALF_SILENT 2   // nothing to play, SysTick stops here
+static uint8_t Buffer[2*SOUND_BLOCK];    // output samples, 0 to 2^OUT_BITS-1
+static volatile uint32_t Ready[2];  // a __DMB() orders each with its half of Buffer
+static volatile uint32_t Samples;   // SysTick, samples played, the next one is Buffer[Samples%(2*SOUND_BLOCK)]
+static bool Quiet;              // SysTick, a sound started after the half it is in was found silent
+static uint32_t Next;           // PendSV, next half to render
+static uint32_t Underruns;
+static uint32_t PendedAt;       // TIMG12 count when PendSV was pended, for its latency
 
+// initialize SysTick at period bus cycles, however no sound should be started
+// SysTick starts with the first sound, see run
 void Sound_Init(uint32_t period, uint32_t priority){
+       if(SOUND_OUTPUT == SOUND_PWM){
+           PWM8_Init();
+       }
+       else{
+           DAC5_Init();
+       }
 
        SysTick->CTRL = 0x00; // disable during initialization
        SysTick->LOAD = period-1; // set reload register
        SCB->SHP[1] = (SCB->SHP[1] & (~0xC0000000)) | priority<<30;
-       SysTick->VAL = 0; // clear count, cause reload
-       SysTick->CTRL = 0x07; // Enable SysTick IRQ and SysTick Timer
+       SCB->SHP[1] = (SCB->SHP[1] & (~0x00C00000)) | 3<<22; // PendSV lowest
+       Gain = 0;
+       Playing = 0;
+       Request = 0;
+       Sample = 0;
+       Notes = 0;
+       Underruns = 0;
+       Samples = 0;
+       Ready[0] = HALF_SILENT;
+       Ready[1] = HALF_SILENT;
+       Next = 0;
 
 }
 
-//extern "C" void SysTick_Handler(void);
-//void SysTick_Handler(void){ // called at 11 kHz
-//
-//    const uint8_t wave[32] = {16,19,22,24,27,28,30,31,31,31,30,28,27,24,22,19,16,13,10,8,5,4,2,1,1,1,2,4,5,8,10,13};
-//    static uint32_t i=0;
-//    DAC5_Out((wave[i]*Data)/4095);
-//    i = (i+1) & 0x1F; // Cycles
-//
-//}
+// Steps every envelope at sample time, a waiting voice attacks once
+// time reaches its start, a voice whose release reaches 0 stops
+static void envelopes(uint32_t time){
+    uint32_t i = 0;
+    while(i < Playing){
+        Voice &v = Voices[i];
+        switch(v.stage){
+        case WAITING:
+            if((int32_t)(time - v.start) < 0){
+                break;
+            }
+            v.increment = v.pitch;
+            v.stage = ATTACK;
+            // fall through
+        case ATTACK:
+            v.level += Attack;
+            if(v.level >= FULL){
+                v.level = FULL;
+                v.stage = DECAY;
+            }
+            break;
+        case DECAY:
+            v.level -= Decay;
+            if(v.level <= SUSTAIN){
+                v.level = SUSTAIN;
+                v.stage = SUSTAINING;
+            }
+            break;
+        case SUSTAINING:
+            break;
+        case RELEASE:
+            v.level -= Release;
+            if(v.level <= 0){
+                v = Voices[--Playing];  // the last voice takes its place, and its turn
+                continue;
+            }
+            break;
+        }
+        i++;
+    }
+}
+
+// Every voice adds its distance from the middle of the wave times its
+// envelope, and a sound asset adds its own at full size. The sum is
+// scaled by the volume gain, a multiply and a shift, rounded and clipped
+// to the DAC. With SOUND_SHAPING each sample's rounding error is taken
+// off the next, about 5 cycles more: the noise is then the error's first
+// difference, rising 6dB an octave, quieter than plain rounding below
+// SOUND_RATE/6 (2.7kHz) and louder above it, where the notes have no
+// fundamentals. One voice at full size and volume is the wave itself, so
+// chords clip on their attack peaks. The game ISR can start notes and
+// sounds part way through, so the voice list and the sound change hands
+// masked, once per envelope step. out[0] plays at sample time.
+static void render(uint8_t *out, uint32_t time){
+    for(uint32_t n = 0; n < SOUND_BLOCK; n += SOUND_CONTROL){
+        uint32_t primask = __get_PRIMASK();
+        __disable_irq();
+        envelopes(time + n);
+        if(Request){
+            Sample = Request;
+            Request = 0;
+            S0 = Adpcm_Start(&Decoder, Sample);
+            S1 = Adpcm_Next(&Decoder);
+            SampleLeft = Sample->samples - 2;
+            SampleFrac = 0;
+        }
+        uint32_t playing = Playing;
+        __set_PRIMASK(primask);
+        for(uint32_t k = n; k < n + SOUND_CONTROL; k++){
+            int32_t sum = 0;            // Q15
+            for(uint32_t i = 0; i < playing; i++){
+                Voice &v = Voices[i];
+                v.phase += v.increment;
+                sum += Wave.sample[v.phase>>27]*v.level;
+            }
+            if(Sample){
+                sum += S0*FULL + (((S1 - S0)*(int32_t)SampleFrac)>>1);
+                SampleFrac += PCM_STEP;
+                if(SampleFrac >= 0x10000){     // under one asset sample a sample, so one decode at most
+                    SampleFrac -= 0x10000;
+                    if(SampleLeft == 0){
+                        Sample = 0;
+                    }
+                    else{
+                        S0 = S1;
+                        S1 = Adpcm_Next(&Decoder);
+                        SampleLeft--;
+                    }
+                }
+            }
+            int32_t mix = (sum>>8)*Gain;
+            if(SOUND_SHAPING){
+                mix -= Shaped;
+            }
+            int32_t step = (mix + (1<<(MIX_SHIFT-1)))>>MIX_SHIFT;   // rounded
+            if(SOUND_SHAPING){
+                Shaped = step*(1<<MIX_SHIFT) - mix;     // within half a step, clipping isn't fed back
+            }
+            int32_t dac = OUT_MIDDLE + step;
+            if(dac < 0){
+                dac = 0;
+            }
+            else if(dac > (1<<OUT_BITS) - 1){
+                dac = (1<<OUT_BITS) - 1;
+            }
+            out[k] = dac;
+        }
+    }
+}
+
+// Renders every half SysTick has handed back, at the lowest priority.
+// SysTick is in the other half, or still in this one after an underrun,
+// and plays it next from the first sample it reaches at its start.
+extern "C" void PendSV_Handler(void);
+void PendSV_Handler(void){
+    LOAD_ISR(LOAD_RENDER, (PendedAt - TIMG12->COUNTERREGS.CTR + GAMECLOCK_FRAME)%GAMECLOCK_FRAME);
+    PROFILE_ZONE("render");
+    while(Ready[Next] == HALF_EMPTY){
+        __DMB();                // SysTick is done reading the half
+        uint32_t primask = __get_PRIMASK();
+        __disable_irq();
+        bool quiet = (Playing == 0 && Sample == 0 && Request == 0);
+        __set_PRIMASK(primask);
+        if(quiet){
+            Ready[Next] = HALF_SILENT;
+        }
+        else{
+            uint32_t samples = Samples;
+            render(&Buffer[Next*SOUND_BLOCK], samples + ((Next*SOUND_BLOCK - samples)&(2*SOUND_BLOCK - 1)));
+            __DMB();            // the half is written before SysTick sees it full
+            Ready[Next] = HALF_FULL;
+        }
+        Next ^= 1;
+    }
+}
 
-//******* Sound_Start ************
-// This function does not output to the DAC. 
-// Rather, it sets a pointer and counter, and then enables the SysTick interrupt.
-// It starts the sound, and the SysTick ISR does the output
-// feel free to change the parameters
-// Sound should play once and stop
-// Input: pt is a pointer to an array of DAC outputs
-//        count is the length of the array
-// Output: none
-// special cases: as you wish to implement
+// Only plays what PendSV rendered. A half that isn't ready in time is
+// an underrun, and plays whatever is in it. At a silent half SysTick
+// stops, and the output stays where it is, unless a sound has started
+// since PendSV found nothing to render; then the half only goes by.
+extern "C" void SysTick_Handler(void);
+void SysTick_Handler(void){ // called at SOUND_RATE
+    LOAD_ISR(LOAD_SYSTICK, SysTick->LOAD - SysTick->VAL);
+    PROFILE_ZONE("SysTick");
+    uint32_t samples = Samples;
+    uint32_t i = samples%(2*SOUND_BLOCK);
+    uint32_t half = i/SOUND_BLOCK;
+    if(i%SOUND_BLOCK == 0){
+        uint32_t ready = Ready[half];
+        __DMB();
+        if(ready == HALF_SILENT && Playing == 0 && Sample == 0 && Request == 0){
+            SysTick->CTRL = 0x00;   // idle, run starts it again on this half
+            return;
+        }
+        Quiet = (ready == HALF_SILENT);
+        if(ready == HALF_EMPTY){
+            Underruns++;
+        }
+    }
+    if(!Quiet){
+        if(SOUND_OUTPUT == SOUND_PWM){
+            PWM8_Out(Buffer[i]);
+        }
+        else{
+            DAC5_Out(Buffer[i]);
+        }
+    }
+    Samples = samples + 1;
+    i++;
+    if(i%SOUND_BLOCK == 0){
+        __DMB();
+        Ready[half] = HALF_EMPTY;
+        if(LOADMETER_MODE != LOADMETER_OFF){
+            PendedAt = TIMG12->COUNTERREGS.CTR;
+        }
+        SCB->ICSR = 0x10000000; // PENDSVSET
+    }
+}
 
-void Sound_Start(uint32_t period){
+// A free voice if there is one, then the oldest that is releasing, then
+// the oldest. A stolen voice keeps its phase and its level and attacks
+// from there, so it changes note without a click.
+static Voice &allocate(void){
+    if(Playing < SOUND_VOICES){
+        Voice &v = Voices[Playing++];
+        v.phase = 0;
+        v.level = 0;
+        return v;
+    }
+    Voice *oldest = &Voices[0];
+    for(uint32_t i = 1; i < SOUND_VOICES; i++){
+        Voice *v = &Voices[i];
+        bool releasing = (v->stage == RELEASE), oldestReleasing = (oldest->stage == RELEASE);
+        if(releasing != oldestReleasing ? releasing : (int32_t)(v->note - oldest->note) < 0){
+            oldest = v;
+        }
+    }
+    return *oldest;
+}
 
-    SysTick->CTRL = 0x00; // disable during initialization
-    SysTick->LOAD = period-1; // set reload register
-    SysTick->VAL = 0; // clear count, cause reload
-    SysTick->CTRL = 0x07; // Enable SysTick IRQ and SysTick Timer
+// Called with interrupts masked. SysTick stopped at the start of a
+// silent half; it starts again on that half filled with silence while
+// PendSV renders the other, so sound starts within two blocks. Samples
+// goes on from where it stopped, the next sample plays SOUND_PERIOD
+// from now.
+static void run(void){
+    if((SysTick->CTRL & 0x01) == 0){
+        uint32_t half = (Samples/SOUND_BLOCK)%2;
+        for(uint32_t i = 0; i < SOUND_BLOCK; i++){
+            Buffer[half*SOUND_BLOCK + i] = OUT_MIDDLE;
+        }
+        Ready[half] = HALF_FULL;
+        Ready[half^1] = HALF_EMPTY;
+        Next = half^1;
+        Quiet = false;
+        if(LOADMETER_MODE != LOADMETER_OFF){
+            PendedAt = TIMG12->COUNTERREGS.CTR;
+        }
+        SCB->ICSR = 0x10000000; // PENDSVSET
+        SysTick->VAL = 0; // clear count, cause reload
+        SysTick->CTRL = 0x07; // Enable SysTick IRQ and SysTick Timer
+    }
+}
 
+// Called with interrupts masked. The sample a GameClock time falls in,
+// now for a time already past. Stopped, SysTick plays Samples next once
+// it starts, which is now.
+static uint32_t sampleAt(uint32_t time){
+    int32_t ahead = (int32_t)(time - GameClock_Now());
+    return Samples + ((ahead > 0) ? (uint32_t)ahead/SOUND_PERIOD : 0);
 }
 
+// Called with interrupts masked. The voice waits for the envelope step
+// that reaches sample, a stolen one sounds its old note until then.
+static void start(uint8_t pitch, uint32_t note, uint32_t sample){
+    Voice &v = allocate();
+    v.pitch = Sound_NoteIncrement(pitch);
+    v.note = note;
+    v.start = sample;
+    v.stage = WAITING;
+    run();
+}
 
+// PendSV renders below the game ISR, so the voices change masked
+uint32_t Sound_Note(uint8_t pitch){
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uint32_t note = Notes++;
+    start(pitch, note, Samples);
+    __set_PRIMASK(primask);
+    return note;
+}
+
+// Root, fifth, octave and the octave's third: consonant over either a
+// major or a minor root
+static const uint8_t ChordTones[SOUND_VOICES] = {0, 7, 12, 16};
+
+uint32_t Sound_Chord(uint8_t root, uint32_t notes, uint32_t time){
+    if(notes > SOUND_VOICES){
+        notes = SOUND_VOICES;
+    }
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uint32_t note = Notes++;
+    uint32_t sample = sampleAt(time);
+    for(uint32_t i = 0; i < notes; i++){
+        start(root + ChordTones[i], note, sample);
+    }
+    __set_PRIMASK(primask);
+    return note;
+}
+
+void Sound_Release(uint32_t note){
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    for(uint32_t i = 0; i < Playing; i++){
+        if(Voices[i].note == note){
+            Voices[i].stage = RELEASE;
+        }
+    }
+    __set_PRIMASK(primask);
+}
+
+void Sound_Off(void){
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    for(uint32_t i = 0; i < Playing; i++){
+        Voices[i].stage = RELEASE;
+    }
+    __set_PRIMASK(primask);
+}
+
+void Sound_Volume(uint32_t reading){
+    Gain = Gains.gain[reading*VOLUME_LEVELS/4096];
+}
+
+uint32_t Sound_Underruns(void){
+    return Underruns;
+}
+
+uint32_t Sound_Voices(void){
+    return Playing;
+}
+
+// 2^32*frequency/SOUND_RATE, frequency in thousandths of a hertz
+static constexpr uint32_t increment(uint64_t milliHz){
+    return (uint32_t)(((milliHz<<32) + 500*SOUND_RATE)/(1000*SOUND_RATE));
+}
+
+// MIDI 60 (C4) through 71 (B4)
+const uint32_t OctaveIncrement[12] = {
+  increment(261626), increment(277183), increment(293665), increment(311127),
+  increment(329628), increment(349228), increment(369994), increment(391995),
+  increment(415305), increment(440000), increment(466164), increment(493883)
+};
+
+uint32_t Sound_NoteIncrement(uint8_t pitch){
+  int32_t octave = pitch/12 - 5;   // octave relative to C4
+  uint32_t step = OctaveIncrement[pitch%12];
+  if(octave >= 0){
+    return step<<octave;
+  }
+  return step>>(-octave);
+}
+
+// A new sound asset takes over from the one playing
+static void play(const AdpcmAsset &asset){
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    Request = &asset;
+    run();
+    __set_PRIMASK(primask);
+}
 
 void Sound_Shoot(void){
-// write this
-  
+    play(shootAdpcm);
 }
 void Sound_Killed(void){
-// write this
-  
+    play(invaderkilledAdpcm);
 }
 void Sound_Explosion(void){
-// write this
-  
+    play(explosionAdpcm);
 }
 
 void Sound_Fastinvader1(void){
-  
+    play(fastinvader1Adpcm);
 }
 void Sound_Fastinvader2(void){
-  
+    play(fastinvader2Adpcm);
 }
 void Sound_Fastinvader3(void){
-  
+    play(fastinvader3Adpcm);
 }
 void Sound_Fastinvader4(void){
-  
+    play(fastinvader4Adpcm);
 }
 void Sound_Highpitch(void){
-  
+    play(highpitchAdpcm);
 }
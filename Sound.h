@@ -1,34 +1,103 @@
 // Sound.h
 // Runs on MSPM0
-// Play sounds on 5-bit DAC.
+// Play sounds on 5-bit DAC, or 8-bit PWM.
+// Direct digital synthesis: each voice steps a 32-bit phase through the
+// 32-sample wave once per sample at the fixed SOUND_RATE, so it costs
+// the same at every pitch. A note sets how far the phase moves each
+// sample; changing it doesn't touch the phase, so notes change without
+// a click.
+// SOUND_VOICES oscillators are mixed, so a chord sounds all its notes.
+// Each voice has an attack/decay/sustain/release envelope in Q15 that
+// steps every SOUND_CONTROL samples, and stops once its release is
+// done.
+// The mix is rendered SOUND_BLOCK samples at a time by PendSV, at the
+// lowest priority, into one half of a ping-pong buffer. SysTick runs at
+// SOUND_RATE and only copies the other half to the DAC, about 40
+// cycles a sample. Rendering visits only the voices that are sounding,
+// about 20 cycles each a sample plus 20 for the mix. SysTick stops once
+// a block renders silent with nothing to play, so an idle game pays for
+// neither ISR, and the next sound starts it again within two blocks, 8ms.
+// The game's clock is TIMG12, see GameClock.h.
 // Your name
 // 11/5/2023
 #ifndef SOUND_H
 #define SOUND_H
 #include <stdint.h>
 
-// initialize a 11kHz SysTick, however no sound should be started
-// initialize any global variables
-// Initialize the 5 bit DAC
-// This is called once
+#define SOUND_RATE   16000                  // samples per second
+#define SOUND_PERIOD (80000000/SOUND_RATE)  // SysTick period in bus cycles
+#define SOUND_VOICES 4                      // notes that can sound at once
+#define SOUND_CONTROL 16                    // samples per envelope step, 1kHz
+#define SOUND_BLOCK  64                     // samples rendered at a time, 4ms
+#define SOUND_LEAD   (2*SOUND_BLOCK*SOUND_PERIOD)  // bus cycles, a note timed this far ahead starts on time
 
+// The output SysTick writes the samples to
+#define SOUND_DAC5 0    // the 5-bit DAC on PB0-PB4, see DAC5.h
+#define SOUND_PWM  1    // 8-bit PWM on PB4, see PWM8.h
+#define SOUND_OUTPUT SOUND_DAC5
+
+// 1 feeds each sample's rounding to the output back into the next, which
+// moves the quantization noise from under the notes toward SOUND_RATE/2,
+// 0 rounds every sample on its own. host/AudioCheck.cpp measures both.
+#define SOUND_SHAPING 1
+
+// initialize SysTick at period bus cycles, however no sound should be started
+// initialize the SOUND_OUTPUT and any global variables
+// This is called once, period is SOUND_PERIOD
 void Sound_Init(uint32_t period, uint32_t priority);
 
-//******* Sound_Start ************
-// This function does not output to the DAC. 
-// Rather, it sets a pointer and counter, and then enables the SysTick interrupt.
-// It starts the sound, and the SysTick ISR does the output
-// feel free to change the parameters
-// Sound should play once and stop
-// Input: pt is a pointer to an array of DAC outputs
-//        count is the length of the array
-// Output: none
-// special cases: as you wish to implement
+//******* Sound_Note ************
+// Plays a pitch on a free voice until Sound_Release or Sound_Off, or
+// until the voice is taken for a newer note, from the next block rendered,
+// starts SysTick if it was off
+// Input: pitch is a MIDI note number, 60 is middle C
+// Output: the note, for Sound_Release
+uint32_t Sound_Note(uint8_t pitch);
+
+//******* Sound_Chord ************
+// Plays root with notes-1 tones above it: the fifth, the octave and
+// the tenth, all as one note. It starts at time on the game clock,
+// rounded up to an envelope step (1ms), if time is at least SOUND_LEAD
+// away, else as soon as it can
+// Input: root is a MIDI note number, notes is 1 to SOUND_VOICES,
+//        time is a GameClock_Now time
+// Output: the note, for Sound_Release
+uint32_t Sound_Chord(uint8_t root, uint32_t notes, uint32_t time);
+
+//******* Sound_Release ************
+// Note off: the note's voices fade out and stop, does nothing if they
+// have been taken for newer notes
+// Input: note from Sound_Note or Sound_Chord
+void Sound_Release(uint32_t note);
+
+//******* Sound_Off ************
+// Releases every voice, SysTick stops once they have all faded
+void Sound_Off(void);
+
+//******* Sound_Volume ************
+// Picks one of 16 gains 2.5dB apart, the top one plays the mix as it is
+// Input: reading is the 12-bit slide pot, under 256 is silent
+void Sound_Volume(uint32_t reading);
+
+//******* Sound_Underruns ************
+// Halves of the buffer SysTick reached before PendSV had rendered them
+uint32_t Sound_Underruns(void);
+
+//******* Sound_Voices ************
+// Voices sounding, releasing ones included, 0 once every note has faded
+uint32_t Sound_Voices(void);
 
-void Sound_Start(uint32_t period);
+//******* Sound_NoteIncrement ************
+// Phase step per sample that plays a MIDI pitch at SOUND_RATE
+// Input: pitch is a MIDI note number, 60 is middle C
+// Output: 2^32*frequency/SOUND_RATE
+uint32_t Sound_NoteIncrement(uint8_t pitch);
 
 // following 8 functions do not output to the DAC
-// they configure pointers/counters and initiate the sound by calling Sound_Start
+// they configure pointers/counters and initiate the sound
+// The sounds/sounds.h assets play at their 11.025kHz, mixed with the
+// notes; a new one replaces the one playing. They are stored as ADPCM in
+// sounds/adpcm.h and decoded as they play, see Adpcm.h.
 
 
 void Sound_Shoot(void);
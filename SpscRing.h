@@ -0,0 +1,100 @@
+/*
+ * SpscRing.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author:
+ *
+ *  Lock-free single-producer single-consumer ring buffer, used to pass
+ *  events between ISRs and the main loop. N must be a power of 2; the put
+ *  and get indices run freely and are masked on access, so all N slots are
+ *  usable and full/empty never need a flag.
+ *
+ *  The Cortex-M0+ has no exclusive load/store, so the two indices are
+ *  plain volatile 32-bit words, a load or store of an aligned word is
+ *  atomic. The producer only writes putI, the consumer only writes getI.
+ *  A __DMB() between a slot and the index that covers it keeps their
+ *  order, for the compiler as well as the core: the slot is written
+ *  before putI publishes it, and read before getI gives it back.
+ */
+
+#ifndef SPSCRING_H_
+#define SPSCRING_H_
+#include <stdint.h>
+#include <ti/devices/msp/msp.h>
+
+template <typename T, uint32_t N>
+class SpscRing
+{
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "SpscRing size must be a power of 2");
+
+public:
+    SpscRing() : putI(0), getI(0) {}
+
+    // producer side
+    bool push(const T &x){
+        uint32_t put = putI;
+        if(put - getI == N)
+            return false;                   // full
+        __DMB();                            // the consumer is done with the slot
+        buf[put & (N - 1)] = x;
+        __DMB();
+        putI = put + 1;
+        return true;
+    }
+
+    // pushes as many of the n elements as fit, returns how many
+    uint32_t push(const T *x, uint32_t n){
+        uint32_t put = putI;
+        uint32_t space = N - (put - getI);
+        if(n > space)
+            n = space;
+        __DMB();
+        for(uint32_t i = 0; i < n; i++){
+            buf[(put + i) & (N - 1)] = x[i];
+        }
+        __DMB();
+        putI = put + n;
+        return n;
+    }
+
+    // consumer side
+    bool pop(T *pt){
+        uint32_t get = getI;
+        if(putI == get)
+            return false;                   // empty
+        __DMB();                            // the slot is read after putI covers it
+        *pt = buf[get & (N - 1)];
+        __DMB();
+        getI = get + 1;
+        return true;
+    }
+
+    // pops up to n elements, returns how many
+    uint32_t pop(T *pt, uint32_t n){
+        uint32_t get = getI;
+        uint32_t count = putI - get;
+        if(n > count)
+            n = count;
+        __DMB();
+        for(uint32_t i = 0; i < n; i++){
+            pt[i] = buf[(get + i) & (N - 1)];
+        }
+        __DMB();
+        getI = get + n;
+        return n;
+    }
+
+    // either side, the answer may be stale by the time it is used
+    uint32_t size(){
+        return putI - getI;
+    }
+    bool isEmpty(){ return size() == 0; }
+    bool isFull(){ return size() == N; }
+
+private:
+    T buf[N];
+    volatile uint32_t putI;    // next slot to put, written by the producer only
+    volatile uint32_t getI;    // next slot to get, written by the consumer only
+};
+
+#endif /* SPSCRING_H_ */
@@ -0,0 +1,38 @@
+// UARTOut.cpp
+// Runs on MSPM0G3507
+// Text out of UART0, see UARTOut.h
+
+#include <stdint.h>
+#include "UARTOut.h"
+#include "../inc/UART.h"
+
+void UARTOut_String(const char *pt){
+    while(*pt){
+        UART_OutChar(*pt++);
+    }
+}
+
+void UARTOut_UDec(uint32_t n){
+    UARTOut_UDecWidth(n, 0);
+}
+
+void UARTOut_UDecWidth(uint32_t n, int width){
+    char digits[10];
+    int count = 0;
+    do{
+        digits[count++] = '0' + n%10;
+        n = n/10;
+    }while(n);
+    for(; width > count; width--){
+        UART_OutChar(' ');
+    }
+    while(count){
+        UART_OutChar(digits[--count]);
+    }
+}
+
+void UARTOut_UHex(uint32_t n){
+    for(int shift = 28; shift >= 0; shift -= 4){
+        UART_OutChar("0123456789ABCDEF"[(n>>shift)&0x0F]);
+    }
+}
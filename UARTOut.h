@@ -0,0 +1,27 @@
+// UARTOut.h
+// Runs on MSPM0G3507
+// Text out of UART0 (PA10, 115200 baud) for the debug reports: LcdStats,
+// LoadMeter, Profile and the Recorder all print on the same port. The
+// Recorder dumps C source and the others print // comments, so a capture
+// with reports mixed in still pastes into Replay.h. Only UART_Init and
+// UART_OutChar (TExaS.cpp) are in the build, UART.c isn't, so these are
+// the few formatters they need. Every call busy-waits on the FIFO, call
+// them from the main loop. main calls UART_Init once, before any of
+// them print.
+
+#ifndef UARTOUT_H_
+#define UARTOUT_H_
+#include <stdint.h>
+
+void UARTOut_String(const char *pt);
+
+// n in decimal, as many digits as it takes
+void UARTOut_UDec(uint32_t n);
+
+// n in decimal right aligned in width characters, spaces in front
+void UARTOut_UDecWidth(uint32_t n, int width);
+
+// n in hex, always 8 digits
+void UARTOut_UHex(uint32_t n);
+
+#endif /* UARTOUT_H_ */
@@ -0,0 +1,276 @@
+// AudioCheck.cpp
+// Runs on Linux
+// Spectral check of the sound output. Each case boots the game, sets the
+// slide pot, holds one note and captures what the sound ISR writes to
+// the DAC once the note has settled to its sustain. The capture is
+// windowed and transformed, and the SNR is the note's power against
+// everything else in a band, harmonics included: over the whole band to
+// SOUND_RATE/2, and under SOUND_RATE/6 where SOUND_SHAPING makes the
+// noise quieter rather than louder. Build with SOUND_SHAPING 0 and 1 to
+// compare them.
+// With every note faded SysTick has to have stopped, nothing plays.
+// Then a game is played until a row is hit with a stray press on another
+// lane before it, which grades it a Miss; the row's chord has to fade out
+// like any other, no voice can be left sounding after it.
+//
+//   audiocheck [-p pitch] [-n samples] [-w prefix]
+//
+//   -p  MIDI note to hold, default 69 (440Hz)
+//   -n  samples to capture, a power of two, default 16384
+//   -w  save each capture as prefixPOT.wav, 16-bit at SOUND_RATE
+//
+// Only the 5-bit DAC is captured, SOUND_OUTPUT has to be SOUND_DAC5.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <complex>
+#include <vector>
+#include <ti/devices/msp/msp.h>
+#include "../GameClock.h"
+#include "../Judge.h"
+#include "../Row.h"
+#include "../Sound.h"
+#include "Player.h"
+#include "Sim.h"
+
+// Lab9HMain.cpp
+#define ROWSLOTS 8
+#define ROWPITCH 30
+extern Judge judge;
+extern uint16_t judgedRow;
+extern bool judgedRowHit;
+extern Row rowArray[ROWSLOTS];
+uint32_t rowHitTime(int16_t rowY);
+
+#define DAC_BITS 5
+#define LOW_BAND (SOUND_RATE/6)     // where first-order shaping breaks even
+#define FLOOR_HZ 20                 // below this is DC, not noise
+#define NOTE_BINS 8                 // the note's main lobe, either side of its peak
+#define MS(ms) GAMECLOCK_MS(ms)
+#define STRAY_MS 240                // the stray press is this far ahead, before the Good window
+#define FADE_MS  150                // a released chord is quiet by then, its release is 80ms
+
+// Slide pot readings, the top volume and two quieter ones
+static const uint32_t Pots[] = {4095, 3072, 2048};
+
+static std::vector<uint8_t> Capture;
+static size_t Wanted;
+
+static void capture(uint32_t data){
+    if(Capture.size() < Wanted){
+        Capture.push_back(data);
+    }
+}
+
+static void put16(FILE *f, uint32_t n){
+    fputc(n & 0xFF, f);
+    fputc((n>>8) & 0xFF, f);
+}
+
+static void put32(FILE *f, uint32_t n){
+    put16(f, n & 0xFFFF);
+    put16(f, n>>16);
+}
+
+// 16-bit mono PCM, the DAC's middle is 0
+static bool writeWav(const char *name, const std::vector<uint8_t> &samples){
+    FILE *f = fopen(name, "wb");
+    if(!f){
+        return false;
+    }
+    uint32_t bytes = samples.size()*2;
+    fputs("RIFF", f);
+    put32(f, 36 + bytes);
+    fputs("WAVEfmt ", f);
+    put32(f, 16);
+    put16(f, 1);                // PCM
+    put16(f, 1);                // mono
+    put32(f, SOUND_RATE);
+    put32(f, SOUND_RATE*2);
+    put16(f, 2);
+    put16(f, 16);
+    fputs("data", f);
+    put32(f, bytes);
+    for(uint8_t s : samples){
+        put16(f, (uint16_t)(int16_t)((s - (1<<(DAC_BITS-1)))*(32768>>(DAC_BITS-1))));
+    }
+    return fclose(f) == 0;
+}
+
+// In place radix-2, the size a power of two
+static void fft(std::vector<std::complex<double>> &x){
+    size_t n = x.size();
+    for(size_t i = 1, j = 0; i < n; i++){
+        size_t bit = n>>1;
+        for(; j & bit; bit >>= 1){
+            j ^= bit;
+        }
+        j ^= bit;
+        if(i < j){
+            std::swap(x[i], x[j]);
+        }
+    }
+    for(size_t len = 2; len <= n; len <<= 1){
+        std::complex<double> w = std::polar(1.0, -2*M_PI/len);
+        for(size_t i = 0; i < n; i += len){
+            std::complex<double> t = 1;
+            for(size_t k = 0; k < len/2; k++){
+                std::complex<double> a = x[i+k], b = x[i+k+len/2]*t;
+                x[i+k] = a + b;
+                x[i+k+len/2] = a - b;
+                t *= w;
+            }
+        }
+    }
+}
+
+// Power in each bin to SOUND_RATE/2, after a Blackman-Harris window
+static std::vector<double> spectrum(const std::vector<uint8_t> &samples){
+    size_t n = samples.size();
+    double mean = 0;
+    for(uint8_t s : samples){
+        mean += s;
+    }
+    mean /= n;
+    std::vector<std::complex<double>> x(n);
+    for(size_t i = 0; i < n; i++){
+        double a = 2*M_PI*i/n;
+        double w = 0.35875 - 0.48829*cos(a) + 0.14128*cos(2*a) - 0.01168*cos(3*a);
+        x[i] = (samples[i] - mean)*w;
+    }
+    fft(x);
+    std::vector<double> power(n/2 + 1);
+    for(size_t i = 0; i <= n/2; i++){
+        power[i] = std::norm(x[i]);
+    }
+    return power;
+}
+
+// Note power over the rest from FLOOR_HZ to top, in dB
+static double snr(const std::vector<double> &power, size_t peak, double binHz, double top){
+    double note = 0, noise = 0;
+    for(size_t i = 0; i < power.size(); i++){
+        double hz = i*binHz;
+        if(i + NOTE_BINS >= peak && i <= peak + NOTE_BINS){
+            note += power[i];
+        }
+        else if(hz >= FLOOR_HZ && hz <= top){
+            noise += power[i];
+        }
+    }
+    return 10*log10(note/noise);
+}
+
+// Plays the first chart until two rows have been hit, presses a lane the
+// row after next doesn't want STRAY_MS before it and stops playing once
+// that row is hit. True if no voice is left once the row's Miss has had
+// FADE_MS, the chord it started faded out.
+static bool strayMiss(void){
+    Player_Init(1, 0, 0);
+    Sim_InputHook(Player_Tick);
+    Player_Click(0x01, GameClock_Now() + MS(100));  // Key4 plays
+    Player_Play(true);
+    uint16_t strayRow = 0xFFFF;
+    uint32_t missed = 0;
+    for(uint32_t ms = 0; ms < 30000; ms++){
+        Sim_Run(SIM_MS(1));
+        if(mode != MODE_GAME){
+            continue;
+        }
+        if(strayRow == 0xFFFF && judge.getCount(Perfect) >= 2){
+            // the row after next, the stray press lands after the next one's window
+            Row &row = rowArray[(judgedRow + 1) & (ROWSLOTS-1)];
+            uint8_t lanes = row.getKeyColors();
+            uint32_t hit = rowHitTime(row.getRowY() + row.getRowHeight() - ROWPITCH);
+            if(lanes && (int32_t)(hit - GameClock_Now()) > (int32_t)MS(STRAY_MS + 20)){
+                uint8_t lane = 1;
+                while(lanes & lane){
+                    lane <<= 1;
+                }
+                Player_Click(lane, hit - MS(STRAY_MS));
+                strayRow = judgedRow + 1;
+            }
+        }
+        else if(judgedRow == strayRow && judgedRowHit){
+            Player_Play(false);     // the rows after it aren't hit, they don't sound
+        }
+        else if(strayRow != 0xFFFF && judge.getCount(Miss) && !missed){
+            missed = GameClock_Now();
+        }
+        else if(missed && (int32_t)(GameClock_Now() - missed) >= (int32_t)MS(FADE_MS)){
+            printf("stray press before hit row %u: %u missed, %u voices %ums after\n",
+                   strayRow, judge.getCount(Miss), Sound_Voices(), FADE_MS);
+            return judge.getCount(Miss) == 1 && Sound_Voices() == 0;
+        }
+    }
+    printf("stray press: the game never got to a hit row graded Miss\n");
+    return false;
+}
+
+int main(int argc, char **argv){
+    uint8_t pitch = 69;
+    size_t samples = 16384;
+    const char *prefix = 0;
+    for(int i = 1; i < argc; i++){
+        if(argv[i][0] == '-' && argv[i][1] && !argv[i][2] && i+1 < argc){
+            switch(argv[i][1]){
+            case 'p': pitch = atoi(argv[++i]); continue;
+            case 'n': samples = atoi(argv[++i]); continue;
+            case 'w': prefix = argv[++i]; continue;
+            }
+        }
+        fprintf(stderr, "usage: audiocheck [-p pitch] [-n samples] [-w prefix]\n");
+        return 2;
+    }
+    if(samples < 256 || (samples & (samples - 1))){
+        fprintf(stderr, "audiocheck: -n must be a power of two from 256\n");
+        return 2;
+    }
+    double hz = 440.0*pow(2.0, (pitch - 69)/12.0);
+    double binHz = (double)SOUND_RATE/samples;
+    size_t peak = (size_t)(hz/binHz + 0.5);
+    printf("note %u %.1fHz, %zu samples, SOUND_SHAPING %d\n", pitch, hz, samples, SOUND_SHAPING);
+
+    Sim_Init(1);
+    Sim_DacHook(capture);
+    for(uint32_t pot : Pots){
+        Sim_Pot(pot);
+        Sim_Run(SIM_MS(50));            // TIMG6 averages the pot and sets the volume
+        uint32_t note = Sound_Note(pitch);
+        Sim_Run(SIM_MS(300));           // past the attack and decay
+        if(!Sim_DacSamples()){
+            fprintf(stderr, "audiocheck: nothing reached the DAC, is SOUND_OUTPUT SOUND_DAC5?\n");
+            return 1;
+        }
+        Capture.clear();
+        Wanted = samples;
+        while(Capture.size() < Wanted){
+            Sim_Run(SIM_MS(10));
+        }
+        Wanted = 0;
+        Sound_Release(note);
+        Sim_Run(SIM_MS(200));           // silent again before the next pot
+        std::vector<double> power = spectrum(Capture);
+        uint32_t lo = 255, hi = 0;
+        for(uint8_t s : Capture){
+            lo = (s < lo) ? s : lo;
+            hi = (s > hi) ? s : hi;
+        }
+        printf("pot %4u  dac %2u-%-2u  snr %5.1fdB to %uHz  %5.1fdB to %uHz\n",
+               pot, lo, hi, snr(power, peak, binHz, SOUND_RATE/2), SOUND_RATE/2,
+               snr(power, peak, binHz, LOW_BAND), LOW_BAND);
+        if(prefix){
+            char name[256];
+            snprintf(name, sizeof name, "%s%u.wav", prefix, pot);
+            if(!writeWav(name, Capture)){
+                fprintf(stderr, "audiocheck: can't write %s\n", name);
+                return 1;
+            }
+        }
+    }
+    bool idle = (SysTick->CTRL & 0x01) == 0;
+    printf("notes faded: SysTick %s\n", idle ? "stopped" : "still running");
+    return (strayMiss() && idle) ? 0 : 1;
+}
@@ -0,0 +1,209 @@
+// DebounceCheck.cpp
+// Runs on Linux
+// Feeds Debounce.h simulated switch bounce and checks every sample's
+// pressed, released and held against a plain per-lane model: a lane
+// changes once DEBOUNCE_SAMPLES samples in a row disagree with it. The
+// fixed cases are chatter shorter and longer than that, and all four
+// lanes changing on the same sample; then long runs of random bounce on
+// four lanes at once.
+//
+//   debouncecheck [-s seed]
+//
+//   -s  seed for the random runs, default 1
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../Debounce.h"
+
+#define DEBOUNCE_SAMPLES 4  // see Debounce.h
+#define LANES 4
+#define RANDOM_SAMPLES 200000
+
+// One lane at a time, the way it reads in Debounce.h
+struct Model {
+    uint32_t state;
+    uint32_t count[LANES];      // samples in a row that disagreed
+    uint32_t down, up;
+
+    Model() : state(0), down(0), up(0){
+        memset(count, 0, sizeof count);
+    }
+
+    void sample(uint32_t in){
+        down = up = 0;
+        for(int lane = 0; lane < LANES; lane++){
+            uint32_t bit = 1u<<lane;
+            if((in ^ state) & bit){
+                count[lane]++;
+            }
+            else{
+                count[lane] = 0;
+            }
+            if(count[lane] == DEBOUNCE_SAMPLES){
+                count[lane] = 0;
+                state ^= bit;
+                if(state & bit){
+                    down |= bit;
+                }
+                else{
+                    up |= bit;
+                }
+            }
+        }
+    }
+};
+
+struct Counts {
+    uint32_t presses, releases;
+};
+
+// Runs inputs through both, false at the first sample they disagree
+static bool run(const char *name, const uint32_t *in, uint32_t n, Counts *counts){
+    Debounce keys;
+    Model model;
+    counts->presses = counts->releases = 0;
+    for(uint32_t i = 0; i < n; i++){
+        keys.sample(in[i]);
+        model.sample(in[i]);
+        if(keys.pressed() != model.down || keys.released() != model.up || keys.held() != model.state){
+            printf("%s: sample %u input %x, pressed %x released %x held %x, expected %x %x %x\n",
+                   name, i, in[i], keys.pressed(), keys.released(), keys.held(),
+                   model.down, model.up, model.state);
+            return false;
+        }
+        counts->presses += __builtin_popcount(keys.pressed());
+        counts->releases += __builtin_popcount(keys.released());
+    }
+    return true;
+}
+
+// Pulses of chatter, each high samples long and low apart, then quiet
+static uint32_t chatter(uint32_t *in, uint32_t lanes, uint32_t high, uint32_t low, uint32_t pulses){
+    uint32_t n = 0;
+    for(uint32_t p = 0; p < pulses; p++){
+        for(uint32_t i = 0; i < high; i++){
+            in[n++] = lanes;
+        }
+        for(uint32_t i = 0; i < low; i++){
+            in[n++] = 0;
+        }
+    }
+    for(uint32_t i = 0; i < 2*DEBOUNCE_SAMPLES; i++){
+        in[n++] = 0;
+    }
+    return n;
+}
+
+// A press that bounces on the way down and up, on lanes together
+static uint32_t bouncyPress(uint32_t *in, uint32_t lanes, uint32_t held){
+    static const uint8_t bounce[] = {1, 0, 1, 1, 0, 1, 0, 0, 1};
+    uint32_t n = 0;
+    for(uint8_t b : bounce){
+        in[n++] = b ? lanes : 0;
+    }
+    for(uint32_t i = 0; i < held; i++){
+        in[n++] = lanes;
+    }
+    for(uint8_t b : bounce){
+        in[n++] = b ? 0 : lanes;
+    }
+    for(uint32_t i = 0; i < 2*DEBOUNCE_SAMPLES; i++){
+        in[n++] = 0;
+    }
+    return n;
+}
+
+static uint32_t In[RANDOM_SAMPLES];
+static int Passed, Total;
+
+static void check(const char *name, uint32_t n, uint32_t presses, uint32_t releases){
+    Counts counts;
+    Total++;
+    if(!run(name, In, n, &counts)){
+        return;
+    }
+    if(counts.presses != presses || counts.releases != releases){
+        printf("%s: %u presses and %u releases, expected %u and %u\n",
+               name, counts.presses, counts.releases, presses, releases);
+        return;
+    }
+    printf("%s: ok\n", name);
+    Passed++;
+}
+
+int main(int argc, char **argv){
+    uint32_t seed = 1;
+    for(int i = 1; i < argc; i++){
+        if(!strcmp(argv[i], "-s") && i+1 < argc){
+            seed = atoi(argv[++i]);
+            continue;
+        }
+        fprintf(stderr, "usage: debouncecheck [-s seed]\n");
+        return 2;
+    }
+
+    // chatter under the count never gets through, however often it comes
+    for(uint32_t high = 1; high < DEBOUNCE_SAMPLES; high++){
+        char name[64];
+        snprintf(name, sizeof name, "chatter %u on 1 off", high);
+        check(name, chatter(In, 0x01, high, 1, 50), 0, 0);
+    }
+    // at the count or over it, every pulse is a press and a release
+    for(uint32_t high = DEBOUNCE_SAMPLES; high < DEBOUNCE_SAMPLES + 3; high++){
+        char name[64];
+        snprintf(name, sizeof name, "pulses %u on %u off", high, DEBOUNCE_SAMPLES);
+        check(name, chatter(In, 0x04, high, DEBOUNCE_SAMPLES, 20), 20, 20);
+    }
+    check("bouncy press lane 3", bouncyPress(In, 0x08, 20), 1, 1);
+    check("four lanes at once", bouncyPress(In, 0x0F, 20), 4, 4);
+
+    // all four pressed and released on the same samples, reported together
+    {
+        uint32_t n = chatter(In, 0x0F, 10, 10, 5);
+        Debounce keys;
+        bool together = true;
+        for(uint32_t i = 0; i < n; i++){
+            keys.sample(In[i]);
+            if((keys.pressed() && keys.pressed() != 0x0F) || (keys.released() && keys.released() != 0x0F)){
+                together = false;
+            }
+        }
+        Total++;
+        if(together){
+            printf("four lanes on one sample: ok\n");
+            Passed++;
+        }
+        else{
+            printf("four lanes on one sample: lanes changed apart\n");
+        }
+    }
+
+    // every lane flips at random with the same chance a sample, so lanes
+    // chatter apart and together, in every mix
+    srandom(seed);
+    for(int r = 0; r < 4; r++){
+        uint32_t chance = 2 << (2*r);     // in 256, from steady to bouncy
+        uint32_t in = 0;
+        for(uint32_t i = 0; i < RANDOM_SAMPLES; i++){
+            for(int lane = 0; lane < LANES; lane++){
+                if((uint32_t)(random() & 0xFF) < chance){
+                    in ^= 1u<<lane;
+                }
+            }
+            In[i] = in;
+        }
+        char name[64];
+        snprintf(name, sizeof name, "random, flips %u/256", chance);
+        Counts counts;
+        Total++;
+        if(run(name, In, RANDOM_SAMPLES, &counts)){
+            printf("%s: ok, %u presses\n", name, counts.presses);
+            Passed++;
+        }
+    }
+
+    printf("%d of %d cases passed\n", Passed, Total);
+    return Passed == Total ? 0 : 1;
+}
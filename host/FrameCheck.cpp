@@ -0,0 +1,547 @@
+// FrameCheck.cpp
+// Runs on Linux
+// Golden-frame regression for the host build. Each scenario boots the
+// game, plays a script of clicks and simulated play through the menu,
+// game and end screens, and at its checkpoints compares the decoded
+// screen with a PPM in golden/. Every frame's SPI traffic is recorded,
+// and a scenario fails if its total or worst frame costs more than its
+// budget in golden/. A renderer change that passes draws the same pixels,
+// and lowering the budgets with -u shows what it saved.
+//
+//   framecheck [-u] [-o dir] [scenario ...]
+//
+//   -u  write the goldens and budgets from this run instead of checking
+//   -o  directory for the screens that didn't match and per-frame CSVs,
+//       default obj/frames
+//
+// Each scenario runs in its own process so it starts from a fresh boot.
+// One scenario records the keys of a game and a later one replays them
+// after a longer boot; the game has to come out the same, as a Recorder
+// capture replayed on a different build has to.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "../GameClock.h"
+#include "../Judge.h"
+#include "Panel.h"
+#include "Player.h"
+#include "Sim.h"
+
+#define MS(ms) GAMECLOCK_MS(ms)
+#define PPM_BYTES (PANEL_WIDTH*PANEL_HEIGHT*3)
+#define END_FRAMES 6000     // a game that hasn't ended by now is a failure
+#define CAPTURE_KEYS 4096   // key changes a capture holds
+
+// Lab9HMain.cpp
+extern Judge judge;
+extern uint8_t scroll;
+extern uint32_t score;
+
+// Lanes of the four keys, Key4 plays, Key3 picks the chart, Key2 the language
+#define KEY1 0x08
+#define KEY2 0x04
+#define KEY3 0x02
+#define KEY4 0x01
+
+enum Action {
+    STEP_CLICK,     // click the keys in lanes
+    STEP_PLAY,      // the player presses the rows
+    STEP_STOP,      // the player leaves the rows alone
+    STEP_WAIT_END,  // run until the end screen
+    STEP_CHECK,     // compare the screen with golden/<scenario>-<name>.ppm
+    STEP_SPEED,     // fail unless the rows scroll lanes pixels a frame
+    STEP_NO_MISS,   // fail if any row has been judged a Miss
+    STEP_RECORD,    // record the keys from here into capture <name>
+    STEP_REPLAY,    // from here the keys come from capture <name>, not the player
+    STEP_RESULT     // recording, save the game's result with the capture;
+                    // replaying, fail unless it is the same
+};
+
+struct Step {
+    uint32_t frames;    // frames to run before the step
+    Action action;
+    uint8_t lanes;      // pixels a frame for STEP_SPEED
+    const char *name;
+};
+
+struct Scenario {
+    const char *name;
+    uint32_t seed;
+    uint32_t errorMs;   // the player's timing error, either way
+    uint32_t bootDelay; // bus cycles the boot takes longer, see Sim_BootDelay
+    const Step *steps;
+    uint32_t count;
+};
+
+// Menu: every chart choice and the language button
+const Step MenuSteps[] = {
+    {10, STEP_CHECK, 0, "title"},
+    {0,  STEP_CLICK, KEY3, 0},
+    {10, STEP_CHECK, 0, "song2"},
+    {0,  STEP_CLICK, KEY3, 0},
+    {10, STEP_CHECK, 0, "endless"},
+    {0,  STEP_CLICK, KEY2, 0},
+    {10, STEP_CHECK, 0, "spanish"},
+    {0,  STEP_CLICK, KEY3, 0},
+    {10, STEP_CHECK, 0, "spanish-song1"},
+};
+
+// A perfect game of the first chart, hold notes included
+const Step WinSteps[] = {
+    {10, STEP_PLAY,  0, 0},
+    {0,  STEP_CLICK, KEY4, 0},
+    {150, STEP_CHECK, 0, "play"},
+    {0,  STEP_WAIT_END, 0, 0},
+    {10, STEP_CHECK, 0, "end"},
+    {0,  STEP_CLICK, KEY1, 0},
+    {10, STEP_CHECK, 0, "menu"},
+};
+
+// The second chart in Spanish with nobody playing
+const Step LoseSteps[] = {
+    {10, STEP_CLICK, KEY2, 0},
+    {10, STEP_CLICK, KEY3, 0},
+    {10, STEP_CLICK, KEY4, 0},
+    {30, STEP_CHECK, 0, "play"},
+    {0,  STEP_WAIT_END, 0, 0},
+    {10, STEP_CHECK, 0, "end"},
+};
+
+// Endless mode played until the scroll has sped up, then left to fail
+const Step EndlessSteps[] = {
+    {10, STEP_PLAY,  0, 0},
+    {0,  STEP_CLICK, KEY3, 0},
+    {10, STEP_CLICK, KEY3, 0},
+    {10, STEP_CLICK, KEY4, 0},
+    {2400, STEP_CHECK, 0, "fast"},
+    {0,  STEP_STOP,  0, 0},
+    {0,  STEP_WAIT_END, 0, 0},
+    {10, STEP_CHECK, 0, "end"},
+};
+
+// Endless mode played a little off the beat through both speed ups. At
+// 3 and 5 pixels a frame the next row is due inside this row's Good
+// window, a press for it mustn't make this row a Miss.
+const Step SpeedSteps[] = {
+    {10, STEP_PLAY,  0, 0},
+    {0,  STEP_CLICK, KEY3, 0},
+    {10, STEP_CLICK, KEY3, 0},
+    {10, STEP_CLICK, KEY4, 0},
+    {1400, STEP_SPEED, 2, 0},
+    {0,  STEP_NO_MISS, 0, 0},
+    {800, STEP_SPEED, 3, 0},
+    {0,  STEP_NO_MISS, 0, 0},
+    {1200, STEP_SPEED, 5, 0},
+    {600, STEP_NO_MISS, 0, 0},
+    {0,  STEP_CHECK, 0, "fastest"},
+};
+
+// The second chart played off the beat, its keys recorded from the menu on
+const Step CaptureSteps[] = {
+    {10, STEP_RECORD, 0, "game"},
+    {0,  STEP_PLAY,  0, 0},
+    {0,  STEP_CLICK, KEY3, 0},
+    {10, STEP_CLICK, KEY4, 0},
+    {0,  STEP_WAIT_END, 0, 0},
+    {10, STEP_RESULT, 0, "game"},
+    {0,  STEP_CHECK, 0, "end"},
+};
+
+// Those keys replayed on a boot that takes longer, a part of a sample
+// more than 3ms. The game clock starts at GameClock_Init, so the keys
+// land on the same frames and the game comes out the same.
+const Step ReplaySteps[] = {
+    {10, STEP_REPLAY, 0, "game"},
+    {0,  STEP_WAIT_END, 0, 0},
+    {10, STEP_RESULT, 0, "game"},
+    {0,  STEP_CHECK, 0, "end"},
+};
+
+#define SCENARIO(name, seed, errorMs, bootDelay, steps) \
+    {name, seed, errorMs, bootDelay, steps, sizeof(steps)/sizeof(Step)}
+const Scenario Scenarios[] = {
+    SCENARIO("menu", 1, 0, 0, MenuSteps),
+    SCENARIO("win", 1, 0, 0, WinSteps),
+    SCENARIO("lose", 1, 0, 0, LoseSteps),
+    SCENARIO("endless", 7, 0, 0, EndlessSteps),
+    SCENARIO("speeds", 3, 40, 0, SpeedSteps),
+    SCENARIO("capture", 5, 60, 0, CaptureSteps),
+    SCENARIO("replay", 5, 0, SIM_MS(3) + 1234, ReplaySteps),   // after capture
+};
+const uint32_t ScenarioCount = sizeof(Scenarios)/sizeof(Scenario);
+
+// What a scenario cost, also the budget it is held to
+struct Cost {
+    uint32_t frames;
+    uint64_t commands;
+    uint64_t data;
+    uint64_t windows;
+    uint64_t pixels;
+    uint64_t worst;     // data bytes in the busiest frame
+};
+
+bool Update = false;
+const char *OutDir = "obj/frames";
+FILE *Csv;
+Cost Spent;
+
+// A key change at a GameClock time
+struct KeyChange {
+    uint32_t time;
+    uint32_t lanes;
+};
+
+KeyChange Capture[CAPTURE_KEYS];
+uint32_t CaptureCount, CaptureNext;
+bool KeysRecorded, KeysReplayed;
+
+// TIMG6 samples the keys at the same clock times on every boot, so a
+// change is replayed at the sample it was recorded at
+void input(void){
+    uint32_t now = GameClock_Now();
+    if(KeysReplayed){
+        while(CaptureNext < CaptureCount && (int32_t)(Capture[CaptureNext].time - now) <= 0){
+            Sim_Keys(Capture[CaptureNext++].lanes);
+        }
+        return;
+    }
+    uint32_t held = Sim_KeysHeld();
+    Player_Tick();
+    if(KeysRecorded && Sim_KeysHeld() != held && CaptureCount < CAPTURE_KEYS){
+        KeyChange k = {now, Sim_KeysHeld()};
+        Capture[CaptureCount++] = k;
+    }
+}
+
+// What a game came to, the same for a capture and its replay
+struct Result {
+    uint32_t frames;
+    uint32_t start;     // clock time of the last frame, a Recorder replay goes by these
+    uint32_t score;
+    uint32_t counts[4];
+};
+
+Result Wanted;     // what the capture being replayed came to
+
+Result result(void){
+    Result r = {Spent.frames, GameClock_FrameStart(), score, {0}};
+    for(int g = Miss; g <= Perfect; g++){
+        r.counts[g] = judge.getCount((Grade)g);
+    }
+    return r;
+}
+
+void printResult(const char *what, const Result &r){
+    printf("  %s: frames %u starting %u score %u miss %u good %u great %u perfect %u\n",
+           what, r.frames, r.start, r.score, r.counts[Miss], r.counts[Good], r.counts[Great], r.counts[Perfect]);
+}
+
+// obj/frames/<name>.keys, a line for the result then one for each change
+bool saveCapture(const char *name){
+    char path[256];
+    snprintf(path, sizeof(path), "%s/%s.keys", OutDir, name);
+    FILE *f = fopen(path, "w");
+    if(f == 0){
+        printf("  can't write %s\n", path);
+        return false;
+    }
+    Result r = result();
+    fprintf(f, "%u %u %u %u %u %u %u\n", r.frames, r.start, r.score, r.counts[Miss], r.counts[Good], r.counts[Great], r.counts[Perfect]);
+    for(uint32_t i = 0; i < CaptureCount; i++){
+        fprintf(f, "%u %u\n", Capture[i].time, Capture[i].lanes);
+    }
+    if(CaptureCount == CAPTURE_KEYS){
+        printf("  capture %s is full\n", name);
+    }
+    return fclose(f) == 0 && CaptureCount < CAPTURE_KEYS;
+}
+
+bool loadCapture(const char *name, Result *r){
+    char path[256];
+    snprintf(path, sizeof(path), "%s/%s.keys", OutDir, name);
+    FILE *f = fopen(path, "r");
+    if(f == 0){
+        printf("  no capture %s, the scenario that records it runs first\n", path);
+        return false;
+    }
+    bool ok = fscanf(f, "%u %u %u %u %u %u %u", &r->frames, &r->start, &r->score, &r->counts[Miss],
+                     &r->counts[Good], &r->counts[Great], &r->counts[Perfect]) == 7;
+    CaptureCount = 0;
+    KeyChange k;
+    while(ok && CaptureCount < CAPTURE_KEYS && fscanf(f, "%u %u", &k.time, &k.lanes) == 2){
+        Capture[CaptureCount++] = k;
+    }
+    fclose(f);
+    if(!ok){
+        printf("  can't read %s\n", path);
+    }
+    return ok;
+}
+
+// Runs one frame and adds up its SPI traffic
+void frame(void){
+    PanelCounts before = Panel_Counts();
+    Sim_RunFrames(1);
+    PanelCounts after = Panel_Counts();
+    PanelCounts f = {after.commands - before.commands, after.data - before.data,
+                     after.windows - before.windows, after.pixels - before.pixels};
+    Spent.frames++;
+    Spent.commands += f.commands;
+    Spent.data += f.data;
+    Spent.windows += f.windows;
+    Spent.pixels += f.pixels;
+    if(f.data > Spent.worst){
+        Spent.worst = f.data;
+    }
+    if(Csv){
+        fprintf(Csv, "%u,%llu,%llu,%llu,%llu,%u\n", GameClock_Frames(),
+                (unsigned long long)f.commands, (unsigned long long)f.data,
+                (unsigned long long)f.windows, (unsigned long long)f.pixels, mode);
+    }
+}
+
+bool loadPPM(const char *path, uint8_t *rgb){
+    FILE *f = fopen(path, "rb");
+    if(f == 0){
+        return false;
+    }
+    int w = 0, h = 0, max = 0;
+    bool ok = fscanf(f, "P6 %d %d %d", &w, &h, &max) == 3 && fgetc(f) != EOF
+           && w == PANEL_WIDTH && h == PANEL_HEIGHT && max == 255
+           && fread(rgb, 1, PPM_BYTES, f) == PPM_BYTES;
+    fclose(f);
+    return ok;
+}
+
+bool check(const char *scenario, const char *name){
+    char path[256];
+    snprintf(path, sizeof(path), "golden/%s-%s.ppm", scenario, name);
+    if(Update){
+        if(!Panel_SavePPM(path)){
+            printf("  %s: can't write %s\n", name, path);
+            return false;
+        }
+        return true;
+    }
+    static uint8_t want[PPM_BYTES], got[PPM_BYTES];
+    if(!loadPPM(path, want)){
+        printf("  %s: no golden %s, run with -u\n", name, path);
+        return false;
+    }
+    Panel_RGB(got);
+    uint32_t wrong = 0;
+    int left = PANEL_WIDTH, right = -1, top = PANEL_HEIGHT, bottom = -1;
+    for(int i = 0; i < PANEL_WIDTH*PANEL_HEIGHT; i++){
+        if(memcmp(&want[3*i], &got[3*i], 3)){
+            int x = i%PANEL_WIDTH, y = i/PANEL_WIDTH;
+            wrong++;
+            left = x < left ? x : left;
+            right = x > right ? x : right;
+            top = y < top ? y : top;
+            bottom = y > bottom ? y : bottom;
+        }
+    }
+    if(wrong == 0){
+        return true;
+    }
+    snprintf(path, sizeof(path), "%s/%s-%s.ppm", OutDir, scenario, name);
+    Panel_SavePPM(path);
+    printf("  %s: %u pixels differ in (%d,%d)-(%d,%d), screen saved as %s\n",
+           name, wrong, left, top, right, bottom, path);
+    return false;
+}
+
+bool loadBudget(const char *path, Cost *c){
+    FILE *f = fopen(path, "r");
+    if(f == 0){
+        return false;
+    }
+    unsigned long long commands, data, windows, pixels, worst;
+    bool ok = fscanf(f, "frames %u commands %llu data %llu windows %llu pixels %llu worst %llu",
+                     &c->frames, &commands, &data, &windows, &pixels, &worst) == 6;
+    c->commands = commands;
+    c->data = data;
+    c->windows = windows;
+    c->pixels = pixels;
+    c->worst = worst;
+    fclose(f);
+    return ok;
+}
+
+bool budget(const char *scenario){
+    char path[256];
+    snprintf(path, sizeof(path), "golden/%s.budget", scenario);
+    if(Update){
+        FILE *f = fopen(path, "w");
+        if(f == 0){
+            printf("  can't write %s\n", path);
+            return false;
+        }
+        fprintf(f, "frames %u\ncommands %llu\ndata %llu\nwindows %llu\npixels %llu\nworst %llu\n",
+                Spent.frames, (unsigned long long)Spent.commands, (unsigned long long)Spent.data,
+                (unsigned long long)Spent.windows, (unsigned long long)Spent.pixels,
+                (unsigned long long)Spent.worst);
+        return fclose(f) == 0;
+    }
+    Cost b;
+    if(!loadBudget(path, &b)){
+        printf("  no budget %s, run with -u\n", path);
+        return false;
+    }
+    bool ok = true;
+    if(Spent.frames != b.frames){
+        printf("  ran %u frames, the budget was made over %u\n", Spent.frames, b.frames);
+        ok = false;
+    }
+    if(Spent.data > b.data || Spent.commands > b.commands){
+        printf("  over budget: %llu data bytes and %llu commands, budget %llu and %llu\n",
+               (unsigned long long)Spent.data, (unsigned long long)Spent.commands,
+               (unsigned long long)b.data, (unsigned long long)b.commands);
+        ok = false;
+    }
+    if(Spent.worst > b.worst){
+        printf("  over budget: worst frame %llu data bytes, budget %llu\n",
+               (unsigned long long)Spent.worst, (unsigned long long)b.worst);
+        ok = false;
+    }
+    if(ok && (Spent.data < b.data || Spent.worst < b.worst)){
+        printf("  under budget by %llu data bytes, worst frame by %llu, -u to lower it\n",
+               (unsigned long long)(b.data - Spent.data), (unsigned long long)(b.worst - Spent.worst));
+    }
+    return ok;
+}
+
+// Plays a scenario from a fresh boot, true if every checkpoint and the budget pass
+bool run(const Scenario &s){
+    char path[256];
+    snprintf(path, sizeof(path), "%s/%s.csv", OutDir, s.name);
+    Csv = fopen(path, "w");
+    if(Csv){
+        fprintf(Csv, "frame,commands,data,windows,pixels,mode\n");
+    }
+    Sim_BootDelay(s.bootDelay);
+    Sim_Init(s.seed);
+    Player_Init(s.seed, s.errorMs, 0);
+    Sim_InputHook(input);
+    Panel_ClearCounts();        // the boot isn't counted
+    bool ok = true;
+    for(uint32_t i = 0; i < s.count; i++){
+        const Step &step = s.steps[i];
+        for(uint32_t f = 0; f < step.frames; f++){
+            frame();
+        }
+        if(step.action == STEP_CLICK){
+            Player_Click(step.lanes, GameClock_Now());
+        }
+        else if(step.action == STEP_PLAY || step.action == STEP_STOP){
+            Player_Play(step.action == STEP_PLAY);
+        }
+        else if(step.action == STEP_WAIT_END){
+            uint32_t f;
+            for(f = 0; f < END_FRAMES && mode != MODE_END; f++){
+                frame();
+            }
+            if(mode != MODE_END){
+                printf("  game didn't end in %u frames\n", END_FRAMES);
+                return false;
+            }
+        }
+        else if(step.action == STEP_SPEED){
+            if(scroll != step.lanes){
+                printf("  scrolling %u pixels a frame at frame %u, expected %u\n", scroll, Spent.frames, step.lanes);
+                ok = false;
+            }
+        }
+        else if(step.action == STEP_RECORD){
+            KeysRecorded = true;
+        }
+        else if(step.action == STEP_REPLAY){
+            if(!loadCapture(step.name, &Wanted)){
+                return false;
+            }
+            KeysReplayed = true;
+        }
+        else if(step.action == STEP_RESULT && KeysRecorded){
+            printResult("recorded", result());
+            ok &= saveCapture(step.name);
+        }
+        else if(step.action == STEP_RESULT){
+            Result got = result();
+            if(memcmp(&Wanted, &got, sizeof(Result)) != 0){
+                printResult("recorded", Wanted);
+                printResult("replayed", got);
+                ok = false;
+            }
+        }
+        else if(step.action == STEP_NO_MISS){
+            if(judge.getCount(Miss)){
+                printf("  %u rows missed by frame %u, %u judged\n", judge.getCount(Miss), Spent.frames,
+                       judge.getCount(Miss) + judge.getCount(Good) + judge.getCount(Great) + judge.getCount(Perfect));
+                ok = false;
+            }
+        }
+        else if(!check(s.name, step.name)){
+            ok = false;
+        }
+    }
+    if(Csv){
+        fclose(Csv);
+    }
+    printf("  %u frames, SPI %llu commands, %llu data bytes, %llu windows, %llu pixels, worst frame %llu bytes\n",
+           Spent.frames, (unsigned long long)Spent.commands, (unsigned long long)Spent.data,
+           (unsigned long long)Spent.windows, (unsigned long long)Spent.pixels,
+           (unsigned long long)Spent.worst);
+    return budget(s.name) && ok;
+}
+
+int main(int argc, char **argv){
+    const char *only[16];
+    uint32_t onlyCount = 0;
+    for(int i = 1; i < argc; i++){
+        if(strcmp(argv[i], "-u") == 0){
+            Update = true;
+        }
+        else if(strcmp(argv[i], "-o") == 0 && i + 1 < argc){
+            OutDir = argv[++i];
+        }
+        else if(argv[i][0] != '-' && onlyCount < 16){
+            only[onlyCount++] = argv[i];
+        }
+        else{
+            fprintf(stderr, "usage: %s [-u] [-o dir] [scenario ...]\n", argv[0]);
+            return 2;
+        }
+    }
+    mkdir(OutDir, 0777);
+    mkdir("golden", 0777);
+
+    uint32_t failed = 0, ran = 0;
+    for(uint32_t i = 0; i < ScenarioCount; i++){
+        bool wanted = (onlyCount == 0);
+        for(uint32_t j = 0; j < onlyCount; j++){
+            wanted |= (strcmp(only[j], Scenarios[i].name) == 0);
+        }
+        if(!wanted){
+            continue;
+        }
+        printf("%s\n", Scenarios[i].name);
+        fflush(stdout);
+        pid_t pid = fork();
+        if(pid == 0){
+            exit(run(Scenarios[i]) ? 0 : 1);
+        }
+        int status = 1;
+        if(pid < 0 || waitpid(pid, &status, 0) != pid || !WIFEXITED(status) || WEXITSTATUS(status)){
+            printf("  FAILED\n");
+            failed++;
+        }
+        ran++;
+    }
+    printf("%u of %u scenarios passed%s\n", ran - failed, ran, Update ? ", goldens and budgets written" : "");
+    return failed != 0;
+}
@@ -0,0 +1,49 @@
+// Headless.cpp
+// Runs on Linux
+// Stands in for ST7735.cpp in the host programs that don't look at the
+// screen. Every draw call the game makes returns at once, so no pixels
+// are made up and nothing goes over SPI1; the game's logic, timing and
+// sound run the same. pianosim and audiocheck link this, framecheck
+// links the real driver and decodes what it sends with Panel.cpp.
+//
+// Only the calls the game sources use are here, a new one is a link
+// error until it gets a stub.
+
+#include <stdint.h>
+#include "../ST7735.h"
+
+uint32_t ST7735_DrawCount[ST7735_DRAWS];    // stay 0, nothing is drawn
+uint32_t ST7735_WindowCount = 0;
+
+void ST7735_InitPrintf(void){
+}
+
+void ST7735_FillScreen(uint16_t color){
+}
+
+void ST7735_FillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color){
+}
+
+void ST7735_DrawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color){
+}
+
+void ST7735_DrawBitmap(int16_t x, int16_t y, const uint16_t *image, int16_t w, int16_t h){
+}
+
+// Same count as the driver, which leaves out one that lands in the last column
+uint32_t ST7735_DrawString(uint16_t x, uint16_t y, char *pt, int16_t textColor){
+    uint32_t count = 0;
+    if(y > 15){
+        return 0;
+    }
+    for(; *pt && x + count < 20; pt++){
+        count++;
+    }
+    return count;
+}
+
+void ST7735_SetCursor(uint32_t newX, uint32_t newY){
+}
+
+void ST7735_OutUDec(uint32_t n, uint16_t color){
+}
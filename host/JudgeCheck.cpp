@@ -0,0 +1,106 @@
+// JudgeCheck.cpp
+// Runs on Linux
+// Plays short scripts of timestamped presses into Judge.h and checks the
+// grade of each row. The cases are timing at the window edges, chords,
+// and the presses that don't belong to the row being judged: before its
+// window, an early press for a later row, a second tap, and a wrong key,
+// which has to cost its own row and not the next one played correctly.
+//
+//   judgecheck
+
+#include <stdint.h>
+#include <stdio.h>
+#include "../Judge.h"
+
+#define MS(ms) GAMECLOCK_MS(ms)
+#define T0 MS(5000)     // hit time of a script's first row
+#define ROWS 4
+#define PRESSES 8
+
+struct Press {
+    uint8_t lane;
+    int32_t ms;         // from T0
+};
+
+struct Script {
+    const char *name;
+    uint8_t lanes[ROWS];        // rows in order, 0 ends the script
+    int32_t hitMs[ROWS];        // from T0
+    Press presses[PRESSES];     // in time order, lane 0xFF ends them
+    Grade expect[ROWS];
+};
+
+#define END {0xFF, 0}
+
+static const Script Scripts[] = {
+    {"perfect, great, good, miss by timing", {0x01, 0x01, 0x01, 0x01}, {0, 500, 1000, 1500},
+     {{0, 40}, {0, 500 - 80}, {0, 1000 + 150}, {0, 1500 + 250}, END},
+     {Perfect, Great, Good, Miss}},
+    {"chord takes its worst lane", {0x05}, {0},
+     {{2, -20}, {0, 90}, END},
+     {Great}},
+    {"chord with a lane missing", {0x05, 0x02}, {0, 500},
+     {{0, 0}, {1, 500}, END},
+     {Miss, Perfect}},
+    {"press before the window is stray", {0x01, 0x01}, {0, 500},
+     {{1, -300}, {0, 0}, {0, 500}, END},
+     {Miss, Perfect}},
+    {"early press for the next row is kept", {0x01, 0x01}, {0, 400},
+     {{0, 0}, {0, 390}, END},
+     {Perfect, Perfect}},
+    {"extra wrong key, next row played correctly", {0x01, 0x02, 0x04}, {0, 500, 1000},
+     {{0, 0}, {2, 50}, {1, 500}, {2, 1000}, END},
+     {Miss, Perfect, Perfect}},
+    {"second tap, next row played correctly", {0x01, 0x02}, {0, 500},
+     {{0, 0}, {0, 60}, {1, 500}, END},
+     {Miss, Perfect}},
+    {"next row's press inside this row's window", {0x01, 0x02, 0x01}, {0, 150, 300},
+     {{0, 0}, {1, 150}, {0, 300}, END},
+     {Perfect, Perfect, Perfect}},
+    {"wrong key after the last row", {0x01}, {0},
+     {{0, 0}, {3, 30}, END},
+     {Miss}},
+};
+
+static int Passed, Total;
+
+// Presses go in as they happen, a row is judged once its window has closed
+static void check(const Script &s){
+    Judge judge(JUDGE_PERFECT_MS, JUDGE_GREAT_MS, JUDGE_GOOD_MS);
+    uint32_t rows = 0;
+    while(rows < ROWS && s.lanes[rows]){
+        rows++;
+    }
+    uint32_t p = 0;
+    bool ok = true;
+    Total++;
+    for(uint32_t r = 0; r < rows; r++){
+        int32_t judgedAt = s.hitMs[r] + JUDGE_GOOD_MS + 1;
+        for(; s.presses[p].lane != 0xFF && s.presses[p].ms < judgedAt; p++){
+            judge.press(s.presses[p].lane, T0 + MS(s.presses[p].ms));
+        }
+        uint8_t nextLanes = (r + 1 < rows) ? s.lanes[r + 1] : 0;
+        uint32_t nextHit = (r + 1 < rows) ? T0 + MS(s.hitMs[r + 1]) : 0;
+        Grade grade = judge.judgeRow(s.lanes[r], T0 + MS(s.hitMs[r]), nextLanes, nextHit);
+        if(grade != s.expect[r]){
+            printf("%s: row %u graded %u, expected %u\n", s.name, r, grade, s.expect[r]);
+            ok = false;
+        }
+    }
+    if(ok){
+        printf("%s: ok\n", s.name);
+        Passed++;
+    }
+}
+
+int main(int argc, char **argv){
+    if(argc > 1){
+        fprintf(stderr, "usage: judgecheck\n");
+        return 2;
+    }
+    for(const Script &s : Scripts){
+        check(s);
+    }
+    printf("%d of %d cases passed\n", Passed, Total);
+    return Passed == Total ? 0 : 1;
+}
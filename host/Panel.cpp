@@ -0,0 +1,157 @@
+// Panel.cpp
+// Runs on Linux
+// Virtual ST7735, see Panel.h
+
+#include <stdint.h>
+#include <stdio.h>
+#include "Panel.h"
+
+#define CMD_CASET  0x2A
+#define CMD_RASET  0x2B
+#define CMD_RAMWR  0x2C
+#define CMD_MADCTL 0x36
+
+#define MADCTL_MV  0x20
+#define MADCTL_BGR 0x08
+
+static uint16_t Picture[PANEL_HEIGHT][PANEL_WIDTH];
+static PanelCounts Counts;
+
+static uint8_t Command;     // last command, the data bytes that follow belong to it
+static uint8_t Params[4];
+static uint32_t ParamCount;
+static uint8_t Madctl;
+static uint8_t XStart, XEnd, YStart, YEnd;  // address window, inclusive
+static uint8_t X, Y;                        // next pixel of a RAMWR
+static uint8_t High;                        // first byte of a pixel
+
+void Panel_Init(void){
+    for(int y = 0; y < PANEL_HEIGHT; y++){
+        for(int x = 0; x < PANEL_WIDTH; x++){
+            Picture[y][x] = 0;
+        }
+    }
+    Command = 0;
+    ParamCount = 0;
+    Madctl = 0;
+    XStart = YStart = 0;
+    XEnd = PANEL_WIDTH - 1;
+    YEnd = PANEL_HEIGHT - 1;
+    X = Y = 0;
+    Panel_ClearCounts();
+}
+
+static void putPixel(uint16_t color){
+    int x = X, y = Y;
+    if(Madctl & MADCTL_MV){     // rows and columns exchanged
+        x = Y;
+        y = X;
+    }
+    if(x < PANEL_WIDTH && y < PANEL_HEIGHT){
+        Picture[y][x] = color;
+    }
+    Counts.pixels++;
+    if(X < XEnd){
+        X++;
+        return;
+    }
+    X = XStart;
+    Y = (Y < YEnd) ? Y + 1 : YStart;
+}
+
+static void startCommand(uint8_t command){
+    Command = command;
+    ParamCount = 0;
+    if(command == CMD_CASET || command == CMD_RASET){
+        Counts.windows++;
+    }
+    if(command == CMD_RAMWR){
+        X = XStart;
+        Y = YStart;
+    }
+}
+
+static void commandData(uint8_t byte){
+    if(Command == CMD_RAMWR){
+        if(ParamCount++ & 1){
+            putPixel((High<<8) | byte);
+        }
+        else{
+            High = byte;
+        }
+        return;
+    }
+    if(ParamCount < 4){
+        Params[ParamCount] = byte;
+    }
+    ParamCount++;
+    if(Command == CMD_CASET && ParamCount == 4){   // 16-bit start and end, only the low bytes matter here
+        XStart = Params[1];
+        XEnd = Params[3];
+    }
+    else if(Command == CMD_RASET && ParamCount == 4){
+        YStart = Params[1];
+        YEnd = Params[3];
+    }
+    else if(Command == CMD_MADCTL && ParamCount == 1){
+        Madctl = byte;
+    }
+}
+
+void Panel_Write(uint8_t byte, bool command){
+    if(command){
+        Counts.commands++;
+        startCommand(byte);
+        return;
+    }
+    Counts.data++;
+    commandData(byte);
+}
+
+uint16_t Panel_Pixel(int x, int y){
+    if(x < 0 || y < 0 || x >= PANEL_WIDTH || y >= PANEL_HEIGHT){
+        return 0;
+    }
+    return Picture[y][x];
+}
+
+const uint16_t *Panel_Pixels(void){
+    return &Picture[0][0];
+}
+
+void Panel_RGB(uint8_t *rgb){
+    for(int y = 0; y < PANEL_HEIGHT; y++){
+        for(int x = 0; x < PANEL_WIDTH; x++){
+            uint16_t c = Picture[y][x];
+            uint8_t hi = (c>>11)&0x1F, g = (c>>5)&0x3F, lo = c&0x1F;
+            uint8_t r = (Madctl & MADCTL_BGR) ? lo : hi;    // 5-6-5, BGR swaps the ends
+            uint8_t b = (Madctl & MADCTL_BGR) ? hi : lo;
+            *rgb++ = (r<<3)|(r>>2);
+            *rgb++ = (g<<2)|(g>>4);
+            *rgb++ = (b<<3)|(b>>2);
+        }
+    }
+}
+
+bool Panel_SavePPM(const char *path){
+    static uint8_t rgb[PANEL_WIDTH*PANEL_HEIGHT*3];
+    FILE *f = fopen(path, "wb");
+    if(f == 0){
+        return false;
+    }
+    Panel_RGB(rgb);
+    fprintf(f, "P6\n%d %d\n255\n", PANEL_WIDTH, PANEL_HEIGHT);
+    fwrite(rgb, 1, sizeof(rgb), f);
+    return fclose(f) == 0;
+}
+
+PanelCounts Panel_Counts(void){
+    return Counts;
+}
+
+void Panel_ClearCounts(void){
+    Counts.commands = 0;
+    Counts.data = 0;
+    Counts.windows = 0;
+    Counts.pixels = 0;
+}
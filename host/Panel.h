@@ -0,0 +1,50 @@
+// Panel.h
+// Runs on Linux
+// Virtual ST7735 for the host build. Decodes the command and data bytes
+// the driver sends over SPI1 (RS on PA13 picks command or data) and keeps
+// the 128x160 picture the real panel would show.
+//
+// CASET and RASET set the address window, RAMWR starts pixel data, two
+// bytes per pixel, filling the window left to right, top to bottom. The
+// MADCTL row/column exchange bit is followed. The mirror bits only say
+// how the glass is mounted, so addresses map straight to pixels the way
+// the driver uses them in rotation 0. The BGR bit picks the color order
+// when the picture is saved.
+
+#ifndef PANEL_H_
+#define PANEL_H_
+#include <stdint.h>
+
+#define PANEL_WIDTH  128
+#define PANEL_HEIGHT 160
+
+// SPI traffic since the last Panel_ClearCounts
+struct PanelCounts {
+    uint64_t commands;  // command bytes, RS low
+    uint64_t data;      // data bytes, RS high, including command parameters
+    uint64_t windows;   // CASET or RASET commands, address window changes
+    uint64_t pixels;    // pixels written with RAMWR
+};
+
+void Panel_Init(void);
+
+// One byte from SPI1, command is true when RS is low
+void Panel_Write(uint8_t byte, bool command);
+
+// Pixel in the driver's 16-bit format, 0 outside the panel
+uint16_t Panel_Pixel(int x, int y);
+
+// Whole picture, PANEL_WIDTH*PANEL_HEIGHT pixels, row by row from the top
+const uint16_t *Panel_Pixels(void);
+
+// Picture as 8-bit red, green, blue, PANEL_WIDTH*PANEL_HEIGHT*3 bytes,
+// the pixels of a PPM
+void Panel_RGB(uint8_t *rgb);
+
+// Saves the picture as a binary PPM, false if the file can't be written
+bool Panel_SavePPM(const char *path);
+
+PanelCounts Panel_Counts(void);
+void Panel_ClearCounts(void);
+
+#endif /* PANEL_H_ */
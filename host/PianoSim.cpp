@@ -0,0 +1,140 @@
+// PianoSim.cpp
+// Runs on Linux
+// Plays the game back to back with a simulated player, headless: the
+// draw calls are stubs, see Headless.cpp, and with nothing to draw the
+// main loop runs once a frame, see Sim_OnePass. A game is a few ms to
+// a few tens of ms, so sweeps of thousands of games are practical.
+// framecheck is where the screen is looked at.
+// The player picks a song on the menu like a person would, presses each
+// row's keys at its hit time give or take a random error, holds hold
+// notes to their tail, sometimes misses a row, and clicks through the end
+// screen. Prints each game's result and how fast the simulation ran.
+//
+//   pianosim [-g games] [-c chart] [-s seed] [-e ms] [-m percent]
+//            [-f frames] [-b]
+//
+//   -g  games to play, default 10
+//   -c  chart to play, ChartCount for endless, default every chart in turn
+//   -s  random seed for the game and the player, default 1
+//   -e  largest timing error in ms, default 60
+//   -m  percent of rows the player doesn't press, default 2
+//   -f  give up after this many game frames in total, default no limit
+//   -b  run the main loop after every interrupt, as on the board
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "../GameClock.h"
+#include "../Judge.h"
+#include "../Chart.h"
+#include "Player.h"
+#include "Sim.h"
+
+// Lab9HMain.cpp
+extern uint32_t chartIndex;
+extern uint32_t lives;
+extern Judge judge;
+uint32_t shownScore();
+
+#define MS(ms) GAMECLOCK_MS(ms)
+
+uint32_t Seed = 1;
+uint32_t ErrorMs = 60;
+uint32_t MissPercent = 2;
+int32_t Chart = -1;
+
+uint32_t LastMode = MODE_END;   // starts the menu script
+uint32_t Games = 0;             // games finished
+uint32_t GamesWanted = 10;
+uint32_t GameFrames;            // frame the current game started on
+
+// Clicks through the menu to the chart wanted, then starts the game
+void menuScript(uint32_t now){
+    uint32_t chart = (Chart >= 0) ? Chart : Games % (ChartCount + 1);
+    uint32_t t = now + MS(200);
+    for(uint32_t i = 0; i < chart; i++){
+        Player_Click(0x02, t);      // Key3 picks the next chart
+        t += MS(150);
+    }
+    Player_Click(0x01, t);          // Key4 plays
+}
+
+void gameOver(uint32_t now){
+    Games++;
+    printf("game %u chart %u frames %u score %u lives %u miss %u good %u great %u perfect %u\n",
+           Games, chartIndex, GameClock_Frames() - GameFrames, shownScore(), lives,
+           judge.getCount(Miss), judge.getCount(Good), judge.getCount(Great), judge.getCount(Perfect));
+    Player_Click(0x01, now + MS(500));  // any key goes back to the menu
+}
+
+// Before every TIMG6 interrupt
+void script(void){
+    uint32_t now = GameClock_Now();
+    if(mode != LastMode){
+        Player_Clear();
+        if(mode == MODE_MENU){
+            menuScript(now);
+        }
+        else if(mode == MODE_GAME){
+            GameFrames = GameClock_Frames();
+        }
+        else{
+            gameOver(now);
+        }
+        LastMode = mode;
+    }
+    Player_Tick();
+}
+
+int main(int argc, char **argv){
+    uint32_t frameLimit = 0;
+    bool onePass = true;
+    for(int i = 1; i < argc; i++){
+        char option = (argv[i][0] == '-') ? argv[i][1] : 0;
+        if(option == 'b'){
+            onePass = false;
+        }
+        else if(i + 1 < argc && option == 'g'){
+            GamesWanted = strtoul(argv[++i], 0, 0);
+        }
+        else if(i + 1 < argc && option == 'c'){
+            Chart = strtol(argv[++i], 0, 0);
+        }
+        else if(i + 1 < argc && option == 's'){
+            Seed = strtoul(argv[++i], 0, 0);
+        }
+        else if(i + 1 < argc && option == 'e'){
+            ErrorMs = strtoul(argv[++i], 0, 0);
+        }
+        else if(i + 1 < argc && option == 'm'){
+            MissPercent = strtoul(argv[++i], 0, 0);
+        }
+        else if(i + 1 < argc && option == 'f'){
+            frameLimit = strtoul(argv[++i], 0, 0);
+        }
+        else{
+            fprintf(stderr, "usage: %s [-g games] [-c chart] [-s seed] [-e ms] [-m percent] [-f frames] [-b]\n", argv[0]);
+            return 2;
+        }
+    }
+    if(Chart > (int32_t)ChartCount){
+        fprintf(stderr, "chart %d: there are %u charts, %u is endless\n", Chart, ChartCount, ChartCount);
+        return 2;
+    }
+
+    clock_t start = clock();
+    Sim_Init(Seed);
+    Sim_OnePass(onePass);
+    Player_Init(Seed, ErrorMs, MissPercent);
+    Player_Play(true);
+    Sim_InputHook(script);
+    while(Games < GamesWanted && (frameLimit == 0 || GameClock_Frames() < frameLimit)){
+        Sim_RunFrames(1);
+    }
+    double wall = (double)(clock() - start)/CLOCKS_PER_SEC;
+    double simulated = (double)Sim_Cycles()/SIM_BUS;
+    printf("%u games, %u frames, %.1f s simulated in %.2f s, %.0f games/s, %.0fx real time\n",
+           Games, GameClock_Frames(), simulated, wall, wall > 0 ? Games/wall : 0, wall > 0 ? simulated/wall : 0);
+    return Games < GamesWanted;
+}
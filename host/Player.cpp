@@ -0,0 +1,124 @@
+// Player.cpp
+// Runs on Linux
+// Simulated player, see Player.h
+
+#include <stdint.h>
+#include "../GameClock.h"
+#include "../Row.h"
+#include "Player.h"
+#include "Sim.h"
+
+// Lab9HMain.cpp
+#define ROWSLOTS  8
+#define ROWPITCH 30
+extern uint16_t judgedRow;
+extern uint16_t topRow;
+extern Row rowArray[ROWSLOTS];
+uint32_t rowHitTime(int16_t rowY);
+
+#define MS(ms) GAMECLOCK_MS(ms)
+#define DEBOUNCE_MS 4   // a press is seen 4 samples after the key goes down
+#define TAP_MS     40   // how long a row that isn't a hold is held
+#define PRESSES     8   // presses planned ahead, power of 2
+#define PLAN_MS   100   // a row is planned this long before its earliest press
+
+struct Press {
+    uint8_t lanes;
+    uint32_t down;      // GameClock times
+    uint32_t up;
+};
+
+static Press Presses[PRESSES];
+static uint32_t PressPut, PressGet;
+static uint16_t PlanRow;        // next row to plan presses for
+static uint32_t LastMode = MODE_MENU;
+static bool Playing;
+
+static uint32_t Seed;
+static uint32_t ErrorMs;
+static uint32_t MissPercent;
+
+static uint32_t random(void){
+    Seed = 1664525*Seed + 1013904223;
+    return Seed>>16;
+}
+
+static bool before(uint32_t a, uint32_t b){
+    return (int32_t)(a - b) < 0;
+}
+
+static void plan(uint8_t lanes, uint32_t down, uint32_t up){
+    if(PressPut - PressGet == PRESSES){
+        return;     // can't happen at the speeds the game scrolls
+    }
+    Press &p = Presses[PressPut++ & (PRESSES-1)];
+    p.lanes = lanes;
+    p.down = down;
+    p.up = up;
+}
+
+// Plans the presses for the rows on screen that are nearly due. A row's
+// hit time is only known once it is close, endless mode speeds the
+// scroll up under the rows already on screen.
+static void planRows(uint32_t now){
+    for(; PlanRow != (uint16_t)(topRow + 1); PlanRow++){
+        Row &row = rowArray[PlanRow & (ROWSLOTS-1)];
+        uint32_t hit = rowHitTime(row.getRowY() + row.getRowHeight() - ROWPITCH);
+        if(!before(hit, now + MS(ErrorMs + DEBOUNCE_MS + PLAN_MS))){
+            break;
+        }
+        uint8_t lanes = row.getKeyColors();
+        if(lanes == 0 || random()%100 < MissPercent){
+            continue;
+        }
+        int32_t error = (int32_t)(random()%(2*ErrorMs + 1)) - (int32_t)ErrorMs;
+        uint32_t down = hit + error*(int32_t)MS(1) - MS(DEBOUNCE_MS);
+        uint32_t up = down + MS(TAP_MS);
+        if(row.getRowHeight() > ROWPITCH){
+            up = rowHitTime(row.getRowY()) + MS(TAP_MS);    // past the tail
+        }
+        plan(lanes, down, up);
+    }
+}
+
+void Player_Init(uint32_t seed, uint32_t errorMs, uint32_t missPercent){
+    Seed = seed;
+    ErrorMs = errorMs;
+    MissPercent = missPercent;
+    Player_Clear();
+}
+
+void Player_Play(bool on){
+    Playing = on;
+}
+
+void Player_Click(uint8_t lanes, uint32_t time){
+    plan(lanes, time, time + MS(PLAYER_CLICK_MS));
+}
+
+void Player_Clear(void){
+    PressPut = PressGet = 0;
+}
+
+void Player_Tick(void){
+    uint32_t now = GameClock_Now();
+    if(mode == MODE_GAME && LastMode != MODE_GAME){
+        PlanRow = judgedRow;
+    }
+    LastMode = mode;
+    if(Playing && mode == MODE_GAME){
+        planRows(now);
+    }
+    // finished presses come off the front, the rest are down between their times
+    while(PressGet != PressPut && !before(now, Presses[PressGet & (PRESSES-1)].up)){
+        PressGet++;
+    }
+    uint32_t keys = 0;
+    for(uint32_t i = PressGet; i != PressPut; i++){
+        Press &p = Presses[i & (PRESSES-1)];
+        if(!before(now, p.down) && before(now, p.up)){
+            keys |= p.lanes;
+        }
+    }
+    Sim_Keys(keys);
+}
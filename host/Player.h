@@ -0,0 +1,36 @@
+// Player.h
+// Runs on Linux
+// Simulated player for the host build. Presses each row's keys at its
+// hit time give or take a random error, holds hold notes to their tail
+// and sometimes misses a row. Menu and end screen clicks are queued with
+// Player_Click. Player_Tick goes in Sim_InputHook, or is called from
+// whatever hook is there, and sets the keys the player is holding.
+
+#ifndef PLAYER_H_
+#define PLAYER_H_
+#include <stdint.h>
+
+// Game state the player reads, Lab9HMain.cpp
+#define MODE_MENU 0
+#define MODE_GAME 1
+#define MODE_END  2
+extern uint32_t mode;
+
+#define PLAYER_CLICK_MS 30  // how long a click holds a key
+
+// errorMs is the largest timing error, missPercent the rows left alone
+void Player_Init(uint32_t seed, uint32_t errorMs, uint32_t missPercent);
+
+// Plays the rows of the game on screen while on
+void Player_Play(bool on);
+
+// Presses lanes at GameClock time, releases them PLAYER_CLICK_MS later
+void Player_Click(uint8_t lanes, uint32_t time);
+
+// Forgets every press not yet finished
+void Player_Clear(void);
+
+// Before each TIMG6 interrupt
+void Player_Tick(void);
+
+#endif /* PLAYER_H_ */
@@ -0,0 +1,125 @@
+// RingCheck.cpp
+// Runs on Linux
+// Two-thread stress test of SpscRing.h. A producer thread pushes a
+// counting sequence and a consumer thread pops it and checks that every
+// value comes out once, in order. The ring is small, so both sides keep
+// running into full and empty; a side that is blocked yields, so the two
+// still interleave on one core. Each case mixes the single and the batch
+// push and pop differently, and the values are wide enough that a slot
+// read before it was written shows up as a torn or stale element.
+//
+//   ringcheck [-n count]
+//
+//   -n  values pushed per case, default 2000000
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+#include "../SpscRing.h"
+
+#define RING 16
+#define BATCH 5     // a batch push or pop moves up to this many
+
+// A sequence number, and the same bits again so a torn copy shows
+struct Item {
+    uint32_t n;
+    uint32_t check;
+};
+
+static uint32_t Count = 2000000;
+
+// batchPush and batchPop say which side uses the batch calls, a third of
+// the time when both do
+static bool stress(const char *name, bool batchPush, bool batchPop){
+    SpscRing<Item, RING> ring;
+    uint32_t fullSpins = 0;
+
+    std::thread producer([&]{
+        uint32_t next = 0;
+        uint32_t turn = 0;
+        while(next < Count){
+            if(batchPush && (turn++%3 != 0 || !batchPop)){
+                Item items[BATCH];
+                uint32_t n = (next%BATCH) + 1;
+                if(n > Count - next){
+                    n = Count - next;
+                }
+                for(uint32_t i = 0; i < n; i++){
+                    items[i].n = next + i;
+                    items[i].check = ~(next + i);
+                }
+                uint32_t pushed = ring.push(items, n);
+                next += pushed;
+                if(pushed == 0){
+                    fullSpins++;
+                    std::this_thread::yield();
+                }
+            }
+            else{
+                Item item = {next, ~next};
+                if(ring.push(item)){
+                    next++;
+                }
+                else{
+                    fullSpins++;
+                    std::this_thread::yield();
+                }
+            }
+        }
+    });
+
+    uint32_t expect = 0;
+    uint32_t emptySpins = 0;
+    bool ok = true;
+    uint32_t turn = 0;
+    while(ok && expect < Count){
+        Item items[BATCH];
+        uint32_t n;
+        if(batchPop && (turn++%3 != 1 || !batchPush)){
+            n = ring.pop(items, (expect%BATCH) + 1);
+        }
+        else{
+            n = ring.pop(&items[0]) ? 1 : 0;
+        }
+        if(n == 0){
+            emptySpins++;
+            std::this_thread::yield();  // on one core the producer needs the time
+        }
+        for(uint32_t i = 0; i < n && ok; i++){
+            if(items[i].n != expect || items[i].check != ~expect){
+                printf("%s: got %u (check %x), expected %u\n", name, items[i].n, items[i].check, expect);
+                ok = false;
+            }
+            expect++;
+        }
+    }
+    producer.join();
+    if(ok && !ring.isEmpty()){
+        printf("%s: %u left over after %u\n", name, ring.size(), Count);
+        ok = false;
+    }
+    if(ok){
+        printf("%s: ok, %u values, %u full and %u empty spins\n", name, Count, fullSpins, emptySpins);
+    }
+    return ok;
+}
+
+int main(int argc, char **argv){
+    for(int i = 1; i < argc; i++){
+        if(!strcmp(argv[i], "-n") && i+1 < argc){
+            Count = atoi(argv[++i]);
+            continue;
+        }
+        fprintf(stderr, "usage: ringcheck [-n count]\n");
+        return 2;
+    }
+    int passed = 0;
+    passed += stress("push, pop", false, false);
+    passed += stress("batch push, pop", true, false);
+    passed += stress("push, batch pop", false, true);
+    passed += stress("both mixed", true, true);
+    printf("%d of 4 cases passed\n", passed);
+    return passed == 4 ? 0 : 1;
+}
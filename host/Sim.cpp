@@ -0,0 +1,372 @@
+// Sim.cpp
+// Runs on Linux
+// Runs the game off-target, see Sim.h. Also stands in for the parts of
+// the board support code that only make sense on the board: the clock,
+// the LaunchPad init, the UART and the DAC.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <ti/devices/msp/msp.h>
+#include "../inc/Clock.h"
+#include "../inc/LaunchPad.h"
+#include "../inc/TExaS.h"
+#include "../inc/UART.h"
+#include "../DAC5.h"
+#include "../GameClock.h"
+#include "Panel.h"
+#include "Sim.h"
+
+// Lab9HMain.cpp
+extern "C" void TIMG12_IRQHandler(void);
+extern "C" void TIMG6_IRQHandler(void);
+extern "C" void SysTick_Handler(void);
+extern "C" void PendSV_Handler(void);
+void gameInit(void);
+void gameLoop(void);
+extern uint32_t M;
+
+#define LOOP_CYCLES 400     // a main loop pass that drew something, besides the SPI bytes
+#define PA13 (1<<13)        // LCD RS, low for a command
+
+GPIO_Regs Mock_GPIOA, Mock_GPIOB;
+IOMUX_Regs Mock_IOMUX;
+GPTIMER_Regs Mock_TIMG0, Mock_TIMG6, Mock_TIMG7, Mock_TIMG8, Mock_TIMG12, Mock_TIMA0, Mock_TIMA1;
+ADC12_Regs Mock_ADC0, Mock_ADC1;
+SPI_Regs Mock_SPI1;
+SysTick_Type Mock_SysTick;
+SCB_Type Mock_SCB;
+NVIC_Type Mock_NVIC;
+
+#define PENDSTSET 0x04000000  // ICSR, SysTick has reloaded and its handler hasn't run
+#define ZERO      0x01        // TIMG RIS, the counter has reloaded and the ISR hasn't run
+
+static uint64_t Now;
+static uint64_t NextG12, NextG6, NextTick;  // cycle each interrupt is due, 0 when it is off
+static uint64_t Soonest;                    // no interrupt is due before this
+static bool IrqOff;
+static bool InISR;
+static bool PendSV;         // pended, runs once nothing else is due
+static bool OnePass;
+static uint64_t BootDelay;
+static uint32_t Keys;
+static void (*InputHook)(void);
+static uint32_t DacOut, DacSamples;
+static void (*DacHook)(uint32_t data);
+
+static uint64_t timerPeriod(GPTIMER_Regs *timer){
+    return (uint64_t)(timer->COUNTERREGS.LOAD + 1)*(timer->COMMONREGS.CPS + 1);
+}
+
+static bool timerOn(GPTIMER_Regs *timer){
+    return (timer->COUNTERREGS.CTRCTL & 0x01) && (timer->CPU_INT.IMASK & 0x01);
+}
+
+// Starts or stops each interrupt to match its registers. The timers count
+// whether or not interrupts are masked, as on the board.
+static void schedule(void){
+    if(!timerOn(TIMG12)){
+        NextG12 = 0;
+    }
+    else if(NextG12 == 0){
+        NextG12 = Now + timerPeriod(TIMG12);
+    }
+    if(!timerOn(TIMG6)){
+        NextG6 = 0;
+    }
+    else if(NextG6 == 0){
+        NextG6 = Now + timerPeriod(TIMG6);
+    }
+    // SysTick stops when disabled or with a reload value of 0
+    if((SysTick->CTRL & 0x03) != 0x03 || SysTick->LOAD == 0){
+        NextTick = 0;
+    }
+    else if(NextTick == 0){
+        NextTick = Now + SysTick->LOAD + 1;
+    }
+}
+
+// Counts left to an interrupt due at next. Masked past it, the counter
+// has reloaded and carried on.
+static uint32_t countdown(uint64_t next, uint64_t period){
+    if(next > Now){
+        return (uint32_t)(next - Now - 1);
+    }
+    return (uint32_t)(period - 1 - (Now - next)%period);
+}
+
+// The timers count down to 0 at the time each interrupt is due
+static void setCounter(void){
+    if(NextG12){
+        TIMG12->COUNTERREGS.CTR = countdown(NextG12, timerPeriod(TIMG12));
+    }
+    TIMG12->CPU_INT.RIS = (NextG12 && NextG12 <= Now) ? ZERO : 0;
+    if(NextG6){
+        TIMG6->COUNTERREGS.CTR = countdown(NextG6, timerPeriod(TIMG6));
+    }
+    if(NextTick){
+        SysTick->VAL.set(countdown(NextTick, SysTick->LOAD + 1));
+    }
+    uint32_t icsr = SCB->ICSR & ~PENDSTSET;
+    SCB->ICSR.set((NextTick && NextTick <= Now) ? icsr | PENDSTSET : icsr);
+}
+
+// Next time an interrupt that has just run is due. Any reloads while it
+// was masked pended it once, the next is the first reload still to come.
+static uint64_t following(uint64_t due, uint64_t period){
+    due += period;
+    if(due < Now){
+        due += (Now - due + period - 1)/period*period;
+    }
+    return due;
+}
+
+// Next due interrupt in priority order, TIMG12 and SysTick before TIMG6
+static uint64_t *nextDue(void){
+    uint64_t *due = 0;
+    uint64_t *order[3] = {&NextG12, &NextTick, &NextG6};
+    for(int i = 0; i < 3; i++){
+        if(*order[i] && (due == 0 || *order[i] < *due)){
+            due = order[i];
+        }
+    }
+    return due;
+}
+
+// Runs every interrupt due up to cycle until, then moves time there
+static void service(uint64_t until){
+    if(InISR){      // interrupts don't nest in the simulation
+        return;
+    }
+    while(!IrqOff){
+        schedule();
+        uint64_t *due = nextDue();
+        if(PendSV && (due == 0 || *due > Now)){    // lowest priority
+            PendSV = false;
+            InISR = true;
+            PendSV_Handler();
+            InISR = false;
+            continue;
+        }
+        if(due == 0 || *due > until){
+            break;
+        }
+        if(*due > Now){
+            Now = *due;
+        }
+        InISR = true;
+        if(due == &NextG12){
+            NextG12 = following(NextG12, timerPeriod(TIMG12));
+            setCounter();
+            TIMG12->CPU_INT.IIDX = 1;
+            TIMG12_IRQHandler();
+        }
+        else if(due == &NextTick){
+            NextTick = following(NextTick, SysTick->LOAD + 1);
+            setCounter();
+            SysTick_Handler();
+        }
+        else{
+            NextG6 = following(NextG6, timerPeriod(TIMG6));
+            setCounter();
+            if(InputHook){
+                InputHook();
+            }
+            TIMG6->CPU_INT.IIDX = 1;
+            TIMG6_IRQHandler();
+        }
+        InISR = false;
+    }
+    if(until > Now){
+        Now = until;
+    }
+    schedule();
+    setCounter();
+    uint64_t *due = nextDue();
+    Soonest = PendSV ? 0 : due ? *due : ~(uint64_t)0;
+}
+
+void Mock_GPIOWrite(GPIO_Regs *port, int op, uint32_t value){
+    if(op == MOCK_GPIO_SET){
+        port->DOUT31_0 |= value;
+    }
+    else if(op == MOCK_GPIO_CLR){
+        port->DOUT31_0 &= ~value;
+    }
+    else{
+        port->DOUT31_0 ^= value;
+    }
+}
+
+// A byte takes 8 SPI clocks of 2*(CLKCTL+1) bus cycles
+void Mock_SPIWrite(uint32_t data){
+    Panel_Write(data, (GPIOA->DOUT31_0 & PA13) == 0);
+    uint64_t until = Now + 16*(SPI1->CLKCTL + 1);
+    if(until < Soonest){    // most bytes, nothing to run
+        Now = until;
+        setCounter();
+        return;
+    }
+    service(until);
+}
+
+void Mock_ICSRWrite(uint32_t value){
+    if(value & 0x10000000){     // PENDSVSET
+        PendSV = true;
+        Soonest = 0;
+    }
+}
+
+void Mock_SysTickClear(void){
+    NextTick = 0;       // reloads, counts a full period from here
+    SysTick->VAL.set(SysTick->LOAD);
+    Soonest = 0;
+}
+
+void Sim_BootDelay(uint64_t cycles){
+    BootDelay = cycles;
+}
+
+void Sim_Init(uint32_t seed){
+    Now = 0;
+    NextG12 = NextG6 = NextTick = 0;
+    PendSV = false;
+    Soonest = 0;
+    SPI1->STAT = 0x03;  // transmit FIFO empty and not full
+    ADC1->ULLMEM.STATUS = 0;
+    Panel_Init();
+    M = seed;
+    gameInit();
+}
+
+// One main loop pass, then time moves on to the next thing that can change
+static void pass(uint64_t end){
+    PanelCounts before = Panel_Counts();
+    gameLoop();
+    PanelCounts after = Panel_Counts();
+    bool drew = (after.commands != before.commands) || (after.data != before.data);
+    uint64_t until = Now + LOOP_CYCLES;
+    schedule();
+    if(OnePass && NextG12){
+        until = NextG12;
+    }
+    else if(!drew){
+        uint64_t *due = nextDue();
+        until = due ? *due : end;
+    }
+    service(until < end ? until : end);
+}
+
+void Sim_Run(uint64_t cycles){
+    uint64_t end = Now + cycles;
+    while(Now < end){
+        pass(end);
+    }
+}
+
+void Sim_RunFrames(uint32_t frames){
+    uint32_t target = GameClock_Frames() + frames;
+    while((int32_t)(GameClock_Frames() - target) < 0){
+        pass(~(uint64_t)0);
+    }
+}
+
+uint64_t Sim_Cycles(void){
+    return Now;
+}
+
+void Sim_OnePass(bool on){
+    OnePass = on;
+}
+
+void Sim_Keys(uint32_t lanes){
+    Keys = lanes;
+    GPIOB->DIN31_0 = (GPIOB->DIN31_0 & ~((1<<12)|(1<<17)))
+                   | ((lanes & 0x08) ? (1<<12) : 0)    // Key1 PB12
+                   | ((lanes & 0x04) ? (1<<17) : 0);   // Key2 PB17
+    GPIOA->DIN31_0 = (GPIOA->DIN31_0 & ~((1u<<31)|(1<<12)))
+                   | ((lanes & 0x02) ? (1u<<31) : 0)   // Key3 PA31
+                   | ((lanes & 0x01) ? (1<<12) : 0);   // Key4 PA12
+}
+
+uint32_t Sim_KeysHeld(void){
+    return Keys;
+}
+
+void Sim_Pot(uint32_t adc){
+    ADC1->ULLMEM.MEMRES[0] = adc;
+}
+
+void Sim_InputHook(void (*hook)(void)){
+    InputHook = hook;
+}
+
+void Sim_DacHook(void (*hook)(uint32_t data)){
+    DacHook = hook;
+}
+
+uint32_t Sim_DacOut(void){
+    return DacOut;
+}
+
+uint32_t Sim_DacSamples(void){
+    return DacSamples;
+}
+
+//////////////////////////////////////////////////////////////////
+// Board support the host build replaces
+
+extern "C" void __disable_irq(void){
+    IrqOff = true;
+}
+
+extern "C" void __enable_irq(void){
+    IrqOff = false;
+}
+
+extern "C" uint32_t __get_PRIMASK(void){
+    return IrqOff;
+}
+
+extern "C" void __set_PRIMASK(uint32_t priMask){
+    IrqOff = priMask & 0x01;
+}
+
+void Clock_Init80MHz(int enablePA14){
+}
+
+uint32_t Clock_Freq(void){
+    return SIM_BUS;
+}
+
+void Clock_Delay(uint32_t cycles){
+    service(Now + cycles);
+}
+
+void Clock_Delay1ms(uint32_t ms){
+    service(Now + SIM_MS(ms));
+}
+
+void LaunchPad_Init(void){
+}
+
+void UART_Init(void){
+    service(Now + BootDelay);
+}
+
+void TExaS_Init(ADC12_Regs *adc12, uint32_t channel, uint8_t (*logic)(void)){
+}
+
+void UART_OutChar(char data){
+    putchar(data);
+}
+
+void DAC5_Init(void){
+}
+
+void DAC5_Out(uint32_t data){
+    DacOut = data;
+    DacSamples++;
+    if(DacHook){
+        DacHook(data);
+    }
+}
@@ -0,0 +1,62 @@
+// Sim.h
+// Runs on Linux
+// Runs the game off-target. The peripherals are the structs in
+// mock/ti/devices/msp/msp.h and this module plays the part of the bus
+// clock and the NVIC: TIMG12, TIMG6 and SysTick interrupts are called at
+// the cycle their counters would reach zero, in priority order when two
+// are due together, and the SysTick and TIMG12 counters are kept current
+// so GameClock reads the simulated time.
+//
+// The main loop runs between interrupts. Each SPI byte costs the cycles
+// SPI1 takes to shift it out, and interrupts that fall due during a draw
+// run right there, as they would preempt it on the board. A pass of the
+// main loop that sends nothing costs nothing, time skips to the next
+// interrupt. Sim_OnePass makes the main loop run once per game frame,
+// which keeps every decision the game makes but draws far less.
+
+#ifndef SIM_H_
+#define SIM_H_
+#include <stdint.h>
+
+#define SIM_BUS 80000000        // bus cycles per second
+#define SIM_MS(ms) ((uint64_t)(ms)*(SIM_BUS/1000))
+
+// Brings the game up the way main does, seed is the random seed
+void Sim_Init(uint32_t seed);
+
+// Extra bus cycles the boot takes before GameClock_Init, the way a build
+// with more to set up takes longer; UART_Init spends them.
+// Set before Sim_Init, 0 by default.
+void Sim_BootDelay(uint64_t cycles);
+
+// Runs the main loop and interrupts for the given number of bus cycles
+void Sim_Run(uint64_t cycles);
+
+// Runs until the game ISR has run frames more times
+void Sim_RunFrames(uint32_t frames);
+
+// Bus cycles since Sim_Init
+uint64_t Sim_Cycles(void);
+
+// Main loop once per game frame rather than back to back
+void Sim_OnePass(bool on);
+
+// Key switches held down, lane n is bit n, Key1 is lane 3 ... Key4 is lane 0
+void Sim_Keys(uint32_t lanes);
+uint32_t Sim_KeysHeld(void);
+
+// Slide pot ADC result, 0 to 4095
+void Sim_Pot(uint32_t adc);
+
+// Called just before each TIMG6 interrupt, where a script or player can
+// change the keys, 0 for none
+void Sim_InputHook(void (*hook)(void));
+
+// Called with every sample the sound ISR writes to the DAC, 0 for none
+void Sim_DacHook(void (*hook)(uint32_t data));
+
+// Last value written to the DAC and how many samples the sound ISR made
+uint32_t Sim_DacOut(void);
+uint32_t Sim_DacSamples(void);
+
+#endif /* SIM_H_ */
@@ -0,0 +1,3 @@
+// Clock.h
+// Host build: sources include "../inc/Clock.h", which resolves here
+#include "../../inc/Clock.h"
@@ -0,0 +1,4 @@
+// DAC5.h
+// Host build: sources include "../inc/DAC5.h", which resolves here.
+// The project uses its own copy in the top directory.
+#include "../../DAC5.h"
@@ -0,0 +1,3 @@
+// LaunchPad.h
+// Host build: sources include "../inc/LaunchPad.h", which resolves here
+#include "../../inc/LaunchPad.h"
@@ -0,0 +1,3 @@
+// SPI.h
+// Host build: sources include "../inc/SPI.h", which resolves here
+#include "../../inc/SPI.h"
@@ -0,0 +1,4 @@
+// ST7735.h
+// Host build: sources include "../inc/ST7735.h", which resolves here.
+// The project uses its own copy in the top directory.
+#include "../../ST7735.h"
@@ -0,0 +1,4 @@
+// SlidePot.h
+// Host build: sources include "../inc/SlidePot.h", which resolves here.
+// The project uses its own copy in the top directory.
+#include "../../SlidePot.h"
@@ -0,0 +1,3 @@
+// TExaS.h
+// Host build: sources include "../inc/TExaS.h", which resolves here
+#include "../../inc/TExaS.h"
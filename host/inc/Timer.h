@@ -0,0 +1,3 @@
+// Timer.h
+// Host build: sources include "../inc/Timer.h", which resolves here
+#include "../../inc/Timer.h"
@@ -0,0 +1,3 @@
+// UART.h
+// Host build: sources include "../inc/UART.h", which resolves here
+#include "../../inc/UART.h"
@@ -0,0 +1,17 @@
+// file.h
+// Runs on Linux
+// Stand-in for the TI runtime's low level I/O header, which ST7735.cpp
+// uses to hook printf up to the LCD. add_device fails on the host, so
+// ST7735_InitPrintf stops after initializing the display and stdout stays
+// the terminal.
+
+#ifndef MOCK_FILE_H_
+#define MOCK_FILE_H_
+
+#define _SSA 0
+
+inline int add_device(const char *, unsigned, ...){
+    return -1;
+}
+
+#endif /* MOCK_FILE_H_ */
@@ -0,0 +1,171 @@
+// msp.h
+// Runs on Linux
+// Stand-in for the MSPM0G3507 device header in the host build. Every
+// peripheral the game touches is a plain struct with the register names
+// the firmware uses, so the sources compile unchanged. Registers that do
+// something when written (the GPIO set/clear/toggle aliases, SPI1 TXDATA,
+// SysTick VAL, SCB ICSR) are small classes that call into Sim.cpp. Everything else
+// just holds what was last written, or what the simulator put there.
+
+#ifndef MOCK_MSP_H_
+#define MOCK_MSP_H_
+#include <stdint.h>
+
+struct GPIO_Regs;
+
+// Hooks the write-active registers call, in Sim.cpp
+void Mock_GPIOWrite(GPIO_Regs *port, int op, uint32_t value);
+void Mock_SPIWrite(uint32_t data);
+void Mock_SysTickClear(void);
+void Mock_ICSRWrite(uint32_t value);
+
+// CMSIS core intrinsics, in Sim.cpp, PRIMASK bit 0 is the interrupt mask
+extern "C" void __disable_irq(void);
+extern "C" void __enable_irq(void);
+extern "C" uint32_t __get_PRIMASK(void);
+extern "C" void __set_PRIMASK(uint32_t priMask);
+// A data memory barrier, a full fence here since ringcheck runs SpscRing on two threads
+inline void __DMB(void){ __atomic_thread_fence(__ATOMIC_SEQ_CST); }
+
+#define MOCK_GPIO_SET 0
+#define MOCK_GPIO_CLR 1
+#define MOCK_GPIO_TGL 2
+
+// DOUTSET31_0, DOUTCLR31_0 and DOUTTGL31_0 act on DOUT31_0, read as 0
+class Mock_GPIOAlias
+{
+public:
+    Mock_GPIOAlias(GPIO_Regs *port, int op) : port(port), op(op) {}
+    Mock_GPIOAlias &operator=(uint32_t value){
+        Mock_GPIOWrite(port, op, value);
+        return *this;
+    }
+    operator uint32_t() const { return 0; }
+private:
+    GPIO_Regs *port;
+    int op;
+};
+
+// A register whose writes go to a hook, reads give the last value written
+template<void (*hook)(uint32_t)>
+class Mock_WriteReg
+{
+public:
+    Mock_WriteReg() : value(0) {}
+    Mock_WriteReg &operator=(uint32_t v){
+        value = v;
+        hook(v);
+        return *this;
+    }
+    operator uint32_t() const { return value; }
+    void set(uint32_t v){ value = v; }  // the simulator, without the hook
+private:
+    uint32_t value;
+};
+
+inline void Mock_SysTickClearHook(uint32_t){ Mock_SysTickClear(); }
+
+struct Mock_GPRCM {
+    volatile uint32_t RSTCTL, PWREN, CLKCFG, STAT;
+};
+
+struct Mock_CPUInt {
+    volatile uint32_t IIDX, IMASK, RIS, MIS, ISET, ICLR;
+};
+
+struct GPIO_Regs {
+    GPIO_Regs() : DOUTSET31_0(this, MOCK_GPIO_SET), DOUTCLR31_0(this, MOCK_GPIO_CLR),
+                  DOUTTGL31_0(this, MOCK_GPIO_TGL) {}
+    Mock_GPRCM GPRCM;
+    volatile uint32_t DOUT31_0;
+    Mock_GPIOAlias DOUTSET31_0;
+    Mock_GPIOAlias DOUTCLR31_0;
+    Mock_GPIOAlias DOUTTGL31_0;
+    volatile uint32_t DOE31_0;
+    volatile uint32_t DIN31_0;     // set by the simulator, the key switches
+    Mock_CPUInt CPU_INT;
+};
+
+struct IOMUX_Regs {
+    struct {
+        volatile uint32_t PINCM[64];
+    } SECCFG;
+};
+
+struct GPTIMER_Regs {
+    Mock_GPRCM GPRCM;
+    volatile uint32_t CLKSEL, CLKDIV;
+    struct {
+        volatile uint32_t CPS, CCLKCTL, CCPD, ODIS;
+    } COMMONREGS;
+    struct {
+        volatile uint32_t CTR, LOAD, CTRCTL;     // CTR is kept up to date by the simulator
+        volatile uint32_t CC_01[2], CCCTL_01[2], OCTL_01[2], CCACT_01[2];
+    } COUNTERREGS;
+    Mock_CPUInt CPU_INT;
+    Mock_CPUInt GEN_EVENT0, GEN_EVENT1;
+};
+
+struct ADC12_Regs {
+    struct {
+        Mock_GPRCM GPRCM;
+        volatile uint32_t CLKFREQ, CTL0, CTL1, CTL2;
+        volatile uint32_t MEMCTL[12];
+        volatile uint32_t SCOMP0;
+        volatile uint32_t STATUS;       // never busy, a conversion is instant
+        volatile uint32_t MEMRES[12];   // set by the simulator, the slide pot
+        Mock_CPUInt CPU_INT;
+    } ULLMEM;
+};
+
+struct SPI_Regs {
+    Mock_GPRCM GPRCM;
+    volatile uint32_t CLKSEL, CLKDIV, CLKCTL, CTL0, CTL1;
+    volatile uint32_t STAT;             // always TFE|TNF, never BUSY
+    Mock_WriteReg<Mock_SPIWrite> TXDATA;
+    volatile uint32_t RXDATA;
+};
+
+struct SysTick_Type {
+    volatile uint32_t CTRL, LOAD;
+    Mock_WriteReg<Mock_SysTickClearHook> VAL;
+    volatile uint32_t CALIB;
+};
+
+struct SCB_Type {
+    Mock_WriteReg<Mock_ICSRWrite> ICSR;     // PENDSVSET pends PendSV_Handler
+    volatile uint32_t SHP[2];
+};
+
+struct NVIC_Type {
+    volatile uint32_t ISER[1], ICER[1], ISPR[1], ICPR[1];
+    volatile uint32_t IP[8];
+};
+
+extern GPIO_Regs Mock_GPIOA, Mock_GPIOB;
+extern IOMUX_Regs Mock_IOMUX;
+extern GPTIMER_Regs Mock_TIMG0, Mock_TIMG6, Mock_TIMG7, Mock_TIMG8, Mock_TIMG12, Mock_TIMA0, Mock_TIMA1;
+extern ADC12_Regs Mock_ADC0, Mock_ADC1;
+extern SPI_Regs Mock_SPI1;
+extern SysTick_Type Mock_SysTick;
+extern SCB_Type Mock_SCB;
+extern NVIC_Type Mock_NVIC;
+
+#define GPIOA   (&Mock_GPIOA)
+#define GPIOB   (&Mock_GPIOB)
+#define IOMUX   (&Mock_IOMUX)
+#define TIMG0   (&Mock_TIMG0)
+#define TIMG6   (&Mock_TIMG6)
+#define TIMG7   (&Mock_TIMG7)
+#define TIMG8   (&Mock_TIMG8)
+#define TIMG12  (&Mock_TIMG12)
+#define TIMA0   (&Mock_TIMA0)
+#define TIMA1   (&Mock_TIMA1)
+#define ADC0    (&Mock_ADC0)
+#define ADC1    (&Mock_ADC1)
+#define SPI1    (&Mock_SPI1)
+#define SysTick (&Mock_SysTick)
+#define SCB     (&Mock_SCB)
+#define NVIC    (&Mock_NVIC)
+
+#endif /* MOCK_MSP_H_ */
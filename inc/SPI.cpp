@@ -19,6 +19,8 @@ J4.31 LCD RS     PA13
 #define PB8INDEX 24
 #define PB15INDEX 31
 #define PA13INDEX 34
+uint32_t SPI_CommandCount = 0; // bytes sent, see SPI.h
+uint32_t SPI_DataCount = 0;
 // calls Clock_Freq to get bus clock
 // initialize SPI for 8 MHz baud clock
 // busy-wait synchronization
@@ -104,6 +106,7 @@ void SPI_OutData(char data){
   while((SPI1->STAT&0x02) == 0x00){}; // spin if TxFifo full
   GPIOA->DOUTSET31_0 = 1<<13;         // RS=PA13=1 for data
   SPI1->TXDATA = data;
+  SPI_DataCount++;
 }
  //---------SPI_OutCommand------------
  // Output 8-bit command to SPI port
@@ -113,6 +116,7 @@ void SPI_OutData(char data){
    while((SPI1->STAT&0x10) == 0x10){}; // spin if SPI busy
    GPIOA->DOUTCLR31_0 = 1<<13;         // RS=PA13=0 for command
    SPI1->TXDATA = command;
+   SPI_CommandCount++;
    while((SPI1->STAT&0x10) == 0x10){}; // spin if SPI busy
  }
 
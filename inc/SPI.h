@@ -35,6 +35,7 @@
   ******************************************************************************/
 #ifndef __SPI_H__
 #define __SPI_H__
+#include <stdint.h>
 
 
 /**
@@ -83,5 +84,19 @@ void SPI_OutCommand(char command);
  * @brief Reset LCD
  */
 void SPI_Reset(void);
+
+/**
+ * Command bytes sent by SPI_OutCommand since reset.
+ * Only written by the code that draws, so another context
+ * may read it at any time; it wraps, so use differences.
+ * @brief Command bytes sent
+ */
+extern uint32_t SPI_CommandCount;
+
+/**
+ * Data bytes sent by SPI_OutData since reset, see SPI_CommandCount
+ * @brief Data bytes sent
+ */
+extern uint32_t SPI_DataCount;
 #endif // __SPI_H__
 /** @}*/
\ No newline at end of file
@@ -0,0 +1,431 @@
+// adpcm.h
+// 4-bit IMA-ADPCM sound assets, made from sounds.h by tools/adpcm, don't edit
+// See Adpcm.h for the format
+#ifndef SOUNDS_ADPCM_H
+#define SOUNDS_ADPCM_H
+#include <stdint.h>
+#include "../Adpcm.h"
+
+const uint8_t shootData[2040] = {
+  15, 55, 190, 67, 171, 33, 180, 28, 18, 140, 66, 203, 17, 148, 12, 49, 156, 50, 203, 18,
+  194, 75, 179, 43, 7, 157, 49, 186, 50, 147, 129, 143, 235, 34, 9, 5, 196, 140, 136, 45,
+  5, 0, 164, 143, 12, 133, 72, 64, 202, 201, 144, 66, 3, 0, 229, 138, 1, 72, 35, 0,
+  190, 137, 8, 38, 0, 81, 249, 200, 128, 49, 6, 0, 181, 141, 44, 8, 67, 80, 184, 171,
+  8, 149, 50, 2, 212, 170, 136, 120, 0, 18, 96, 189, 136, 216, 66, 0, 0, 197, 140, 44,
+  136, 51, 2, 149, 172, 138, 62, 128, 66, 0, 201, 186, 200, 132, 48, 4, 0, 203, 142, 28,
+  130, 64, 1, 133, 156, 138, 13, 51, 9, 3, 165, 159, 136, 28, 20, 8, 2, 196, 170, 136,
+  62, 128, 66, 80, 152, 218, 136, 17, 16, 21, 0, 0, 207, 136, 129, 48, 52, 128, 80, 250,
+  138, 40, 8, 83, 132, 0, 80, 159, 136, 0, 67, 130, 32, 80, 189, 138, 200, 48, 133, 40,
+  1, 150, 157, 136, 136, 67, 147, 56, 1, 250, 156, 136, 24, 68, 137, 19, 112, 169, 170, 136,
+  88, 129, 17, 5, 144, 144, 191, 136, 13, 33, 131, 57, 65, 153, 188, 140, 136, 6, 32, 146,
+  48, 96, 202, 154, 137, 76, 0, 34, 146, 56, 150, 188, 154, 232, 33, 16, 3, 24, 82, 185,
+  187, 158, 136, 4, 49, 51, 138, 34, 182, 189, 170, 200, 81, 16, 18, 147, 41, 114, 203, 156,
+  136, 24, 6, 16, 16, 145, 24, 178, 207, 138, 136, 72, 20, 25, 40, 150, 8, 161, 189, 153,
+  136, 76, 19, 8, 18, 10, 50, 234, 187, 189, 248, 32, 32, 33, 160, 57, 148, 137, 160, 239,
+  137, 216, 32, 2, 8, 17, 138, 2, 162, 172, 219, 142, 232, 16, 18, 1, 153, 17, 152, 34,
+  217, 218, 201, 136, 72, 33, 35, 146, 11, 18, 10, 20, 175, 201, 234, 136, 60, 17, 51, 152,
+  25, 161, 74, 49, 250, 152, 220, 138, 8, 65, 67, 163, 8, 194, 9, 35, 169, 16, 174, 204,
+  201, 216, 49, 18, 34, 178, 9, 145, 29, 51, 171, 0, 249, 190, 152, 138, 66, 22, 16, 16,
+  168, 136, 178, 74, 4, 170, 16, 205, 171, 206, 16, 1, 67, 19, 9, 145, 170, 17, 171, 99,
+  179, 27, 136, 191, 217, 253, 0, 1, 16, 34, 129, 9, 8, 170, 24, 168, 66, 131, 171, 152,
+  240, 188, 143, 153, 17, 20, 65, 66, 128, 9, 144, 140, 129, 170, 64, 1, 17, 242, 137, 8,
+  157, 202, 188, 33, 17, 51, 55, 17, 17, 176, 137, 136, 141, 0, 140, 32, 178, 67, 148, 172,
+  26, 218, 25, 250, 172, 25, 0, 82, 3, 81, 35, 0, 0, 170, 138, 216, 24, 9, 13, 56,
+  170, 48, 19, 49, 210, 174, 152, 241, 9, 162, 255, 203, 64, 50, 50, 6, 205, 136, 82, 200,
+  8, 65, 200, 136, 66, 201, 8, 81, 201, 8, 97, 201, 136, 98, 201, 136, 82, 216, 8, 81,
+  200, 9, 81, 208, 9, 65, 196, 137, 80, 180, 11, 64, 179, 13, 56, 164, 140, 32, 149, 140,
+  24, 5, 156, 24, 36, 172, 128, 68, 202, 128, 98, 201, 136, 97, 208, 9, 64, 180, 11, 72,
+  148, 13, 24, 6, 157, 0, 68, 187, 0, 114, 201, 9, 81, 196, 10, 64, 163, 141, 16, 7,
+  157, 0, 68, 202, 128, 98, 216, 9, 64, 179, 140, 32, 134, 157, 0, 68, 202, 128, 82, 196,
+  10, 48, 149, 141, 16, 36, 188, 0, 114, 216, 9, 64, 163, 141, 16, 36, 172, 8, 98, 216,
+  9, 64, 148, 141, 16, 36, 203, 8, 97, 193, 10, 32, 6, 157, 0, 82, 201, 9, 49, 149,
+  141, 16, 68, 202, 128, 65, 178, 140, 16, 69, 187, 0, 82, 192, 10, 16, 21, 172, 0, 81,
+  193, 10, 16, 69, 172, 0, 66, 209, 10, 16, 69, 187, 0, 81, 177, 140, 16, 52, 219, 8,
+  49, 164, 141, 0, 83, 201, 9, 33, 133, 157, 0, 82, 196, 10, 16, 36, 188, 0, 64, 163,
+  142, 24, 82, 216, 136, 32, 20, 188, 0, 49, 164, 142, 0, 66, 196, 10, 32, 99, 202, 128,
+  33, 133, 157, 16, 49, 180, 141, 16, 82, 208, 9, 16, 83, 202, 8, 32, 68, 156, 8, 33,
+  149, 141, 0, 49, 211, 139, 16, 98, 208, 137, 16, 82, 217, 136, 17, 83, 202, 8, 16, 36,
+  188, 0, 17, 21, 173, 0, 17, 133, 157, 0, 17, 133, 157, 0, 33, 149, 156, 0, 33, 148,
+  142, 24, 32, 149, 156, 0, 17, 133, 157, 0, 17, 133, 172, 0, 17, 68, 172, 0, 1, 84,
+  187, 0, 1, 84, 186, 136, 17, 98, 217, 8, 16, 65, 224, 137, 16, 49, 196, 139, 16, 49,
+  151, 140, 24, 1, 68, 172, 0, 1, 51, 251, 9, 1, 65, 196, 10, 16, 32, 164, 142, 0,
+  1, 68, 187, 8, 17, 114, 200, 137, 16, 33, 165, 141, 0, 17, 83, 203, 8, 17, 65, 196,
+  138, 16, 17, 4, 159, 0, 1, 65, 232, 137, 17, 16, 133, 157, 128, 2, 81, 201, 137, 16,
+  17, 133, 157, 8, 17, 49, 241, 138, 16, 17, 99, 187, 8, 17, 49, 196, 141, 0, 1, 82,
+  217, 9, 16, 16, 19, 190, 24, 16, 49, 166, 141, 24, 16, 49, 241, 10, 24, 1, 82, 218,
+  136, 1, 1, 36, 204, 8, 17, 16, 132, 158, 8, 17, 32, 164, 143, 24, 16, 48, 166, 140,
+  0, 1, 33, 181, 140, 24, 1, 49, 197, 140, 16, 16, 48, 196, 140, 24, 1, 33, 181, 142,
+  0, 1, 32, 164, 142, 8, 1, 16, 4, 189, 0, 1, 1, 52, 205, 136, 17, 0, 82, 233,
+  9, 0, 1, 48, 211, 141, 0, 1, 32, 132, 189, 24, 1, 1, 99, 218, 137, 1, 1, 33,
+  181, 143, 0, 1, 0, 115, 186, 136, 17, 16, 72, 211, 140, 24, 1, 0, 83, 251, 8, 0,
+  1, 32, 163, 175, 0, 17, 0, 81, 224, 138, 16, 1, 16, 66, 236, 8, 16, 0, 16, 132,
+  173, 25, 1, 1, 64, 195, 157, 8, 2, 1, 64, 196, 142, 0, 1, 0, 48, 210, 141, 24,
+  1, 1, 48, 227, 141, 0, 1, 0, 48, 180, 159, 0, 1, 16, 40, 149, 189, 24, 17, 16,
+  40, 52, 207, 8, 16, 16, 128, 66, 232, 139, 17, 16, 0, 48, 150, 159, 8, 1, 1, 128,
+  67, 250, 137, 16, 16, 0, 56, 148, 175, 24, 16, 0, 129, 66, 241, 155, 16, 2, 1, 24,
+  99, 251, 9, 16, 0, 129, 16, 35, 207, 9, 17, 16, 0, 16, 20, 207, 8, 17, 0, 0,
+  40, 20, 237, 8, 16, 0, 129, 0, 67, 236, 137, 17, 16, 0, 8, 66, 241, 140, 16, 16,
+  0, 0, 40, 149, 190, 24, 17, 16, 0, 8, 99, 232, 140, 1, 1, 1, 8, 16, 21, 206,
+  8, 16, 1, 128, 0, 48, 165, 191, 0, 17, 1, 0, 0, 88, 195, 174, 8, 18, 16, 128,
+  0, 64, 148, 207, 8, 17, 1, 0, 8, 24, 37, 221, 10, 17, 1, 16, 8, 128, 82, 226,
+  157, 24, 17, 1, 128, 128, 24, 53, 252, 138, 17, 1, 1, 128, 128, 56, 53, 223, 137, 17,
+  32, 128, 129, 136, 16, 38, 236, 138, 2, 17, 16, 8, 136, 128, 84, 224, 141, 24, 17, 1,
+  128, 8, 136, 32, 22, 237, 9, 17, 16, 0, 8, 136, 0, 48, 5, 223, 9, 17, 17, 128,
+  0, 8, 9, 56, 38, 237, 138, 18, 1, 16, 8, 128, 136, 136, 69, 210, 190, 16, 17, 17,
+  0, 8, 136, 136, 8, 70, 225, 173, 16, 17, 17, 128, 128, 144, 128, 152, 115, 131, 239, 9,
+  17, 17, 0, 8, 136, 128, 137, 145, 100, 161, 207, 8, 33, 32, 24, 136, 128, 9, 136, 144,
+  112, 51, 238, 154, 33, 17, 1, 129, 136, 144, 25, 168, 130, 120, 22, 251, 155, 33, 17, 2,
+  0, 8, 168, 128, 24, 152, 41, 86, 3, 255, 153, 33, 17, 16, 8, 8, 9, 25, 153, 128,
+  24, 73, 55, 210, 206, 9, 33, 18, 0, 0, 136, 9, 9, 144, 152, 2, 139, 100, 22, 242,
+  173, 25, 49, 17, 129, 128, 136, 160, 146, 9, 24, 154, 178, 133, 105, 38, 160, 239, 10, 32,
+  18, 17, 128, 8, 27, 137, 160, 2, 154, 2, 136, 195, 128, 115, 69, 145, 239, 170, 33, 19,
+  18, 0, 128, 9, 153, 41, 11, 178, 105, 139, 147, 137, 40, 128, 91, 114, 7, 144, 207, 170,
+  33, 51, 18, 0, 136, 8, 43, 170, 56, 139, 180, 138, 149, 179, 74, 139, 144, 128, 49, 0,
+  136, 119, 37, 153, 239, 170, 25, 20, 35, 17, 136, 136, 144, 103, 159, 0, 16, 211, 41, 25,
+  196, 41, 41, 227, 24, 25, 195, 41, 25, 196, 58, 42, 197, 41, 25, 196, 41, 25, 196, 24,
+  25, 211, 24, 25, 196, 24, 42, 179, 136, 42, 20, 172, 0, 83, 188, 146, 99, 156, 162, 66,
+  141, 145, 49, 139, 160, 65, 193, 26, 56, 199, 41, 42, 196, 41, 42, 162, 137, 24, 98, 172,
+  146, 82, 141, 145, 33, 137, 153, 33, 213, 41, 42, 197, 8, 8, 18, 171, 162, 100, 141, 145,
+  17, 160, 9, 40, 199, 24, 25, 146, 169, 129, 115, 141, 145, 33, 152, 10, 16, 214, 0, 8,
+  48, 187, 146, 82, 155, 8, 72, 214, 24, 9, 1, 169, 0, 113, 139, 144, 17, 198, 25, 24,
+  32, 171, 129, 112, 138, 9, 40, 213, 0, 25, 64, 156, 129, 17, 227, 25, 24, 1, 170, 128,
+  83, 155, 10, 18, 183, 9, 137, 84, 13, 136, 16, 196, 8, 8, 96, 140, 129, 24, 212, 0,
+  136, 49, 14, 128, 16, 210, 0, 8, 48, 13, 136, 16, 212, 0, 25, 32, 170, 144, 2, 150,
+  154, 0, 88, 210, 9, 128, 83, 157, 129, 40, 213, 24, 25, 32, 11, 153, 2, 35, 158, 24,
+  56, 215, 24, 136, 49, 141, 145, 0, 3, 141, 0, 57, 214, 24, 25, 40, 153, 160, 146, 100,
+  141, 128, 16, 178, 136, 57, 74, 229, 24, 25, 32, 154, 160, 146, 84, 142, 145, 1, 1, 139,
+  24, 73, 228, 0, 25, 24, 212, 8, 24, 40, 177, 138, 1, 97, 140, 144, 162, 68, 14, 144,
+  129, 96, 140, 145, 1, 72, 140, 128, 129, 17, 140, 16, 24, 147, 187, 32, 128, 7, 141, 129,
+  16, 2, 188, 16, 130, 5, 157, 129, 128, 22, 172, 1, 8, 83, 173, 128, 1, 82, 143, 129,
+  145, 49, 14, 161, 146, 33, 29, 152, 146, 18, 169, 144, 32, 16, 231, 24, 8, 8, 213, 0,
+  24, 8, 16, 155, 145, 163, 100, 15, 128, 129, 24, 177, 25, 24, 0, 231, 0, 24, 8, 16,
+  155, 129, 0, 114, 13, 136, 129, 0, 229, 0, 8, 0, 32, 140, 128, 1, 40, 201, 129, 0,
+  24, 183, 9, 9, 131, 112, 14, 8, 16, 8, 243, 0, 136, 1, 72, 13, 177, 18, 136, 212,
+  16, 10, 8, 66, 14, 160, 3, 58, 161, 224, 1, 8, 40, 212, 8, 136, 2, 104, 14, 145,
+  129, 136, 179, 8, 24, 8, 24, 199, 58, 137, 131, 120, 13, 144, 162, 2, 56, 141, 128, 56,
+  60, 243, 0, 41, 8, 128, 229, 0, 8, 128, 16, 227, 8, 8, 128, 32, 192, 8, 24, 8,
+  88, 200, 128, 0, 128, 113, 140, 128, 129, 128, 133, 62, 138, 179, 128, 64, 200, 128, 16, 8,
+  133, 192, 9, 8, 65, 61, 214, 40, 10, 40, 42, 225, 32, 58, 139, 64, 24, 15, 128, 129,
+  176, 134, 11, 136, 179, 35, 62, 128, 76, 59, 8, 128, 129, 61, 139, 128, 1, 120, 12, 8,
+  0, 40, 128, 225, 136, 16, 128, 24, 135, 13, 8, 181, 56, 75, 184, 8, 24, 128, 199, 48,
+  12, 8, 196, 128, 64, 59, 60, 184, 64, 60, 59, 192, 8, 88, 139, 16, 130, 225, 179, 8
+};
+const AdpcmAsset shootAdpcm = {shootData, 4080, 256, 66};
+
+const uint8_t invaderkilledData[1688] = {
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 119, 119, 255, 255, 104, 209, 16, 135, 155, 52, 159, 20, 219,
+  66, 200, 33, 184, 61, 181, 76, 194, 75, 180, 61, 179, 77, 211, 91, 196, 28, 68, 157, 150,
+  12, 132, 45, 197, 59, 132, 13, 198, 26, 67, 205, 68, 203, 49, 212, 92, 228, 88, 184, 76,
+  180, 28, 4, 46, 164, 186, 69, 204, 52, 205, 68, 186, 106, 227, 105, 224, 65, 185, 76, 211,
+  91, 211, 91, 211, 75, 147, 188, 68, 219, 66, 192, 75, 180, 11, 150, 44, 131, 142, 5, 172,
+  68, 219, 51, 233, 82, 188, 67, 216, 64, 209, 92, 242, 80, 192, 59, 166, 28, 197, 60, 67,
+  173, 68, 204, 52, 172, 72, 180, 28, 36, 158, 6, 188, 68, 205, 69, 205, 69, 173, 69, 204,
+  83, 189, 36, 224, 72, 212, 60, 181, 77, 146, 172, 53, 205, 52, 172, 80, 226, 105, 200, 88,
+  216, 49, 242, 106, 209, 76, 195, 43, 132, 140, 36, 205, 68, 173, 38, 158, 6, 14, 133, 29,
+  148, 28, 132, 204, 68, 204, 69, 205, 67, 202, 50, 216, 74, 180, 11, 150, 77, 162, 203, 38,
+  174, 22, 142, 21, 205, 67, 217, 65, 185, 108, 208, 105, 226, 90, 195, 60, 196, 75, 147, 63,
+  179, 139, 71, 204, 68, 189, 53, 188, 51, 201, 106, 196, 59, 66, 205, 67, 202, 65, 200, 72,
+  194, 27, 52, 205, 69, 188, 83, 187, 52, 189, 53, 188, 51, 201, 106, 211, 91, 162, 156, 22,
+  205, 52, 172, 50, 218, 81, 187, 36, 232, 65, 185, 92, 211, 76, 146, 204, 37, 188, 51, 201,
+  123, 226, 105, 225, 92, 210, 91, 194, 10, 21, 205, 69, 204, 36, 202, 49, 208, 106, 209, 92,
+  210, 92, 226, 89, 193, 75, 195, 58, 147, 14, 4, 141, 21, 158, 53, 189, 37, 205, 36, 216,
+  106, 225, 88, 212, 76, 178, 138, 53, 205, 36, 186, 108, 226, 89, 194, 27, 36, 174, 22, 173,
+  52, 202, 64, 225, 105, 225, 92, 196, 10, 37, 174, 38, 172, 88, 212, 76, 146, 219, 69, 173,
+  37, 205, 37, 173, 67, 156, 50, 248, 65, 201, 80, 201, 50, 203, 36, 156, 50, 240, 92, 212,
+  90, 194, 42, 132, 29, 148, 171, 71, 172, 80, 225, 72, 211, 42, 19, 175, 70, 157, 65, 226,
+  106, 209, 106, 225, 104, 216, 88, 226, 106, 208, 104, 216, 80, 201, 64, 226, 90, 211, 74, 1,
+  205, 37, 172, 50, 218, 65, 216, 65, 185, 64, 212, 92, 209, 89, 212, 57, 18, 207, 21, 173,
+  37, 187, 50, 241, 92, 161, 139, 6, 204, 68, 202, 50, 156, 88, 228, 92, 161, 28, 131, 141,
+  6, 205, 36, 202, 51, 158, 50, 228, 106, 193, 10, 69, 158, 38, 158, 21, 172, 51, 232, 88,
+  208, 88, 225, 105, 196, 10, 69, 206, 36, 202, 35, 187, 82, 201, 65, 171, 21, 187, 82, 186,
+  67, 157, 21, 156, 64, 228, 108, 208, 90, 195, 42, 66, 207, 21, 202, 108, 228, 92, 145, 156,
+  135, 30, 132, 140, 150, 45, 19, 207, 21, 157, 68, 187, 65, 242, 74, 162, 60, 195, 10, 6,
+  31, 165, 27, 133, 141, 70, 189, 37, 157, 66, 216, 80, 216, 108, 225, 92, 212, 57, 131, 207,
+  37, 188, 66, 185, 108, 228, 104, 216, 88, 226, 73, 162, 61, 162, 12, 6, 173, 7, 14, 5,
+  158, 22, 187, 112, 186, 97, 232, 65, 201, 80, 241, 121, 216, 104, 228, 92, 193, 74, 162, 28,
+  148, 140, 135, 46, 147, 157, 38, 173, 36, 156, 65, 224, 104, 225, 90, 210, 57, 163, 30, 132,
+  13, 150, 29, 165, 60, 162, 12, 150, 12, 21, 143, 6, 206, 69, 172, 20, 201, 108, 209, 58,
+  195, 74, 178, 138, 71, 174, 6, 186, 109, 242, 88, 161, 12, 133, 46, 180, 9, 21, 143, 151,
+  13, 68, 173, 21, 156, 66, 216, 80, 216, 105, 177, 219, 70, 142, 36, 218, 81, 186, 80, 242,
+  88, 161, 140, 134, 29, 4, 206, 6, 157, 6, 142, 70, 173, 21, 141, 6, 157, 51, 173, 6,
+  156, 65, 242, 92, 144, 12, 150, 13, 134, 30, 149, 141, 38, 142, 65, 244, 108, 192, 74, 178,
+  138, 23, 142, 5, 142, 51, 244, 104, 224, 72, 178, 59, 148, 62, 178, 138, 71, 157, 20, 186,
+  120, 226, 88, 224, 72, 194, 90, 209, 40, 131, 143, 134, 29, 132, 141, 134, 13, 149, 12, 21,
+  158, 20, 186, 97, 216, 50, 217, 121, 225, 88, 224, 88, 209, 40, 163, 29, 20, 158, 5, 13,
+  51, 219, 80, 240, 120, 216, 80, 240, 96, 216, 88, 177, 11, 135, 13, 133, 13, 20, 172, 50,
+  232, 80, 201, 80, 176, 11, 7, 14, 5, 142, 36, 156, 65, 224, 40, 67, 143, 6, 141, 50,
+  248, 65, 201, 80, 201, 49, 209, 25, 4, 142, 134, 140, 35, 172, 5, 155, 96, 225, 8, 21,
+  143, 20, 224, 72, 162, 44, 130, 142, 6, 156, 35, 187, 98, 186, 5, 170, 104, 209, 72, 192,
+  56, 145, 141, 150, 28, 148, 28, 148, 12, 5, 14, 50, 249, 50, 186, 120, 193, 41, 194, 73,
+  160, 10, 135, 141, 5, 140, 4, 13, 19, 141, 4, 155, 35, 233, 104, 200, 24, 3, 15, 133,
+  13, 133, 141, 5, 155, 65, 241, 72, 176, 89, 176, 9, 6, 30, 132, 13, 50, 248, 80, 216,
+  64, 176, 25, 4, 15, 133, 13, 4, 170, 66, 217, 80, 201, 65, 216, 48, 177, 10, 22, 141,
+  132, 12, 133, 140, 19, 171, 36, 218, 50, 202, 65, 201, 65, 201, 50, 171, 96, 208, 40, 147,
+  30, 164, 26, 131, 14, 149, 28, 131, 13, 19, 232, 64, 200, 88, 200, 32, 147, 47, 146, 139,
+  7, 140, 19, 171, 82, 217, 80, 216, 80, 201, 64, 176, 41, 147, 15, 35, 187, 5, 155, 82,
+  201, 49, 232, 64, 160, 26, 4, 14, 132, 12, 49, 232, 80, 201, 64, 192, 56, 177, 90, 176,
+  41, 132, 14, 4, 155, 80, 208, 88, 184, 24, 132, 13, 132, 140, 4, 139, 133, 12, 148, 11,
+  133, 154, 80, 200, 16, 147, 13, 132, 12, 3, 140, 4, 155, 35, 156, 65, 224, 56, 177, 73,
+  176, 9, 135, 12, 132, 28, 33, 233, 64, 176, 24, 3, 15, 48, 216, 32, 178, 43, 4, 14,
+  33, 201, 19, 186, 112, 192, 56, 176, 56, 210, 25, 4, 14, 131, 12, 3, 139, 80, 224, 64,
+  185, 16, 4, 14, 33, 216, 32, 146, 13, 148, 10, 34, 203, 65, 208, 24, 131, 30, 148, 11,
+  34, 248, 64, 184, 64, 185, 80, 184, 48, 208, 32, 177, 74, 177, 58, 132, 15, 3, 155, 35,
+  234, 65, 185, 80, 184, 64, 185, 49, 192, 25, 149, 28, 131, 12, 49, 248, 32, 161, 74, 160,
+  9, 134, 12, 131, 12, 3, 155, 4, 186, 83, 171, 50, 209, 59, 179, 43, 135, 29, 147, 12,
+  18, 170, 4, 12, 19, 156, 49, 240, 32, 128, 12, 132, 138, 64, 200, 48, 184, 40, 148, 14,
+  3, 170, 65, 208, 40, 178, 25, 19, 143, 49, 233, 49, 185, 48, 193, 57, 162, 13, 5, 155,
+  80, 200, 16, 131, 14, 131, 11, 148, 138, 81, 201, 33, 176, 25, 133, 29, 130, 11, 132, 12,
+  3, 186, 67, 187, 98, 201, 32, 163, 29, 147, 29, 18, 171, 49, 195, 12, 20, 156, 50, 202,
+  65, 216, 48, 176, 25, 133, 12, 148, 11, 34, 248, 33, 184, 64, 184, 32, 162, 14, 132, 11,
+  18, 170, 97, 200, 32, 193, 40, 162, 29, 34, 249, 33, 184, 48, 193, 73, 152, 58, 195, 58,
+  163, 15, 132, 11, 3, 186, 98, 170, 17, 180, 60, 145, 12, 5, 139, 18, 202, 82, 186, 50,
+  232, 32, 161, 26, 50, 204, 65, 216, 17, 146, 29, 33, 186, 65, 216, 33, 160, 59, 164, 28,
+  149, 27, 148, 28, 2, 12, 131, 155, 20, 12, 48, 241, 40, 129, 13, 3, 139, 50, 219, 65,
+  200, 48, 192, 24, 34, 173, 35, 156, 35, 156, 35, 219, 66, 201, 80, 168, 25, 148, 28, 2,
+  155, 4, 139, 51, 188, 34, 196, 28, 132, 11, 65, 217, 48, 176, 57, 195, 27, 36, 142, 131,
+  139, 49, 243, 57, 176, 24, 149, 29, 48, 216, 16, 162, 43, 148, 28, 18, 202, 49, 177, 29,
+  133, 139, 65, 216, 32, 177, 42, 149, 29, 147, 27, 34, 172, 18, 180, 29, 131, 12, 49, 233,
+  33, 193, 73, 168, 40, 163, 30, 49, 218, 32, 162, 43, 148, 29, 131, 186, 98, 185, 64, 168,
+  25, 149, 28, 18, 187, 50, 211, 44, 148, 28, 49, 233, 16, 130, 13, 131, 138, 34, 156, 65,
+  201, 48, 193, 41, 131, 15, 33, 201, 33, 161, 28, 132, 139, 4, 155, 81, 216, 64, 169, 0,
+  34, 14, 16, 193, 40, 177, 25, 150, 11, 50, 235, 65, 169, 48, 200, 0, 50, 204, 50, 202,
+  17, 148, 12, 49, 249, 33, 168, 72, 184, 32, 195, 43, 132, 13, 49, 218, 33, 161, 27, 67,
+  157, 49, 217, 17, 162, 29, 50, 172, 65, 201, 33, 161, 27, 150, 28, 147, 11, 133, 11, 131,
+  12, 81, 202, 33, 178, 27, 4, 156, 51, 188, 50, 196, 28, 3, 155, 66, 218, 50, 187, 52,
+  157, 33, 211, 26, 3, 13, 2, 139, 33, 182, 28, 18, 140, 18, 186, 113, 184, 16, 17, 14,
+  32, 208, 32, 161, 43, 148, 11, 82, 218, 33, 177, 58, 163, 31, 2, 170, 66, 216, 32, 177,
+  42, 149, 12, 64, 200, 16, 163, 29, 148, 27, 33, 224, 0, 147, 29, 48, 201, 16, 164, 27,
+  65, 217, 0, 3, 13, 16, 227, 24
+};
+const AdpcmAsset invaderkilledAdpcm = {invaderkilledData, 3377, 0, 0};
+
+const uint8_t explosionData[1000] = {
+  9, 24, 117, 32, 171, 13, 72, 65, 161, 222, 170, 48, 69, 1, 155, 173, 9, 36, 24, 56,
+  33, 84, 17, 200, 172, 188, 156, 16, 16, 84, 147, 128, 51, 163, 205, 156, 0, 66, 162, 137,
+  51, 53, 1, 201, 250, 204, 172, 137, 0, 65, 36, 33, 0, 37, 1, 153, 10, 100, 2, 0,
+  150, 170, 218, 203, 8, 136, 17, 184, 156, 136, 14, 16, 70, 18, 33, 1, 144, 187, 237, 172,
+  136, 136, 61, 19, 34, 34, 160, 173, 8, 0, 216, 174, 137, 32, 49, 54, 16, 152, 139, 0,
+  19, 186, 75, 87, 0, 0, 128, 251, 188, 139, 24, 36, 50, 128, 169, 156, 202, 9, 128, 96,
+  21, 160, 186, 57, 66, 20, 65, 98, 185, 189, 139, 24, 83, 51, 176, 174, 137, 136, 136, 16,
+  86, 35, 0, 0, 0, 201, 236, 139, 136, 136, 31, 1, 136, 17, 0, 8, 66, 51, 0, 0,
+  135, 0, 0, 240, 172, 171, 136, 232, 66, 128, 170, 9, 34, 1, 0, 17, 117, 3, 0, 112,
+  185, 154, 32, 35, 145, 206, 140, 136, 136, 200, 99, 34, 0, 0, 186, 187, 236, 136, 136, 136,
+  115, 3, 0, 17, 64, 184, 40, 18, 0, 240, 173, 16, 34, 130, 186, 187, 153, 8, 17, 146,
+  239, 11, 67, 34, 17, 84, 1, 0, 0, 0, 246, 171, 26, 33, 51, 20, 217, 188, 138, 136,
+  33, 52, 2, 33, 192, 205, 138, 128, 32, 16, 32, 161, 160, 188, 33, 116, 53, 3, 169, 172,
+  24, 185, 186, 96, 85, 82, 136, 152, 169, 153, 152, 32, 3, 17, 129, 0, 154, 56, 37, 1,
+  145, 189, 186, 206, 154, 8, 41, 160, 234, 138, 16, 0, 115, 22, 17, 18, 145, 192, 201, 190,
+  172, 25, 49, 37, 33, 34, 2, 218, 137, 8, 145, 221, 155, 25, 34, 99, 18, 145, 9, 68,
+  8, 218, 187, 81, 54, 35, 0, 96, 251, 187, 201, 34, 0, 1, 136, 186, 170, 170, 49, 116,
+  68, 129, 170, 138, 0, 17, 32, 67, 192, 175, 187, 8, 49, 54, 3, 218, 154, 16, 160, 136,
+  114, 37, 67, 136, 153, 152, 201, 190, 138, 136, 136, 37, 144, 32, 18, 144, 65, 53, 20, 0,
+  144, 25, 2, 120, 206, 202, 138, 136, 72, 4, 184, 154, 48, 34, 129, 16, 99, 39, 0, 0,
+  151, 171, 9, 50, 18, 233, 204, 136, 136, 136, 60, 38, 2, 0, 160, 187, 203, 142, 136, 136,
+  56, 55, 0, 16, 1, 132, 139, 34, 1, 0, 223, 10, 33, 34, 168, 187, 155, 137, 16, 33,
+  249, 175, 32, 36, 17, 33, 22, 0, 0, 0, 96, 221, 154, 16, 34, 67, 149, 202, 155, 136,
+  200, 49, 19, 1, 17, 235, 157, 8, 8, 2, 128, 2, 9, 218, 27, 67, 101, 51, 128, 187,
+  138, 152, 188, 139, 87, 20, 0, 0, 128, 187, 186, 138, 50, 2, 144, 136, 177, 1, 160, 56,
+  43, 128, 192, 128, 128, 187, 3, 249, 155, 145, 144, 232, 128, 132, 249, 136, 178, 58, 60, 8,
+  61, 186, 130, 128, 251, 42, 180, 128, 128, 128, 128, 112, 160, 5, 144, 240, 223, 8, 42, 103,
+  130, 186, 171, 10, 32, 101, 37, 0, 0, 250, 154, 16, 144, 153, 136, 136, 138, 136, 200, 95,
+  68, 0, 96, 136, 144, 169, 153, 152, 144, 218, 50, 131, 169, 138, 24, 51, 54, 52, 6, 0,
+  0, 80, 190, 187, 136, 136, 8, 23, 0, 137, 136, 128, 0, 1, 1, 1, 0, 240, 175, 9,
+  33, 83, 35, 35, 2, 3, 0, 8, 88, 255, 143, 136, 136, 49, 130, 186, 170, 136, 136, 32,
+  129, 141, 114, 20, 152, 56, 53, 146, 203, 170, 137, 8, 128, 233, 155, 114, 38, 136, 137, 128,
+  153, 40, 128, 64, 5, 128, 144, 190, 172, 154, 136, 1, 17, 176, 50, 115, 22, 8, 153, 136,
+  136, 136, 8, 140, 54, 1, 137, 152, 9, 9, 41, 25, 128, 16, 137, 138, 133, 33, 140, 184,
+  252, 168, 116, 18, 153, 168, 11, 172, 50, 40, 137, 184, 179, 252, 223, 97, 19, 1, 168, 171,
+  138, 10, 136, 1, 8, 16, 40, 40, 129, 48, 76, 136, 8, 136, 255, 255, 56, 34, 1, 136,
+  0, 54, 35, 0, 176, 191, 188, 137, 153, 80, 3, 17, 144, 205, 170, 153, 137, 136, 52, 86,
+  52, 145, 185, 170, 138, 9, 0, 17, 0, 222, 16, 1, 97, 69, 133, 153, 136, 152, 49, 1,
+  24, 192, 205, 185, 137, 8, 1, 17, 16, 17, 0, 251, 173, 8, 114, 37, 1, 32, 2, 0,
+  112, 170, 185, 204, 154, 136, 136, 44, 52, 129, 169, 72, 39, 128, 137, 9, 34, 194, 206, 155,
+  24, 82, 3, 160, 185, 170, 153, 170, 32, 118, 68, 1, 0, 112, 152, 154, 137, 32, 17, 169,
+  169, 137, 8, 129, 17, 17, 17, 49, 25, 3, 255, 159, 9, 33, 67, 51, 51, 6, 0, 0,
+  135, 158, 137, 16, 17, 169, 219, 139, 136, 200, 81, 50, 1, 153, 161, 188, 170, 9, 168, 120,
+  54, 0, 128, 128, 136, 8, 16, 0, 0, 1, 16, 136, 0, 184, 195, 139, 139, 203, 244, 252,
+  174, 138, 48, 83, 99, 20, 0, 0, 80, 219, 155, 41, 52, 34, 200, 205, 138, 136, 136, 136,
+  76, 38, 2, 153, 153, 186, 154, 136, 0, 129, 25, 136, 16, 119, 36, 129, 137, 50, 0, 144,
+  191, 155, 16, 8, 50, 176, 204, 169, 9, 16, 1, 18, 129, 80, 131, 250, 26, 37, 2, 152,
+  152, 65, 67, 99, 160, 203, 171, 141, 152, 9, 67, 129, 17, 188, 204, 202, 141, 32, 147, 88,
+  53, 4, 137, 72, 0, 0, 217, 188, 138, 136, 64, 161, 136, 82, 3, 202, 27, 66, 86, 20,
+  132, 136, 202, 172, 169, 138, 8, 16, 83, 35, 160, 185, 137, 137, 82, 101, 33, 17, 51, 8
+};
+const AdpcmAsset explosionAdpcm = {explosionData, 2000, -2048, 49};
+
+const uint8_t fastinvader1Data[491] = {
+  169, 171, 139, 41, 50, 85, 49, 50, 35, 20, 2, 33, 145, 128, 138, 186, 159, 171, 218, 185,
+  234, 153, 155, 171, 156, 156, 27, 130, 22, 131, 25, 204, 187, 188, 159, 136, 136, 136, 136, 136,
+  136, 136, 136, 136, 136, 117, 20, 37, 19, 53, 18, 50, 22, 50, 33, 65, 65, 128, 128, 128,
+  128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 8, 255, 255, 169, 139, 172, 200,
+  202, 169, 10, 173, 169, 170, 187, 139, 143, 10, 141, 249, 188, 136, 136, 136, 136, 136, 120, 66,
+  51, 65, 49, 56, 128, 128, 176, 187, 188, 228, 169, 217, 185, 169, 154, 171, 203, 160, 216, 65,
+  38, 131, 0, 170, 189, 202, 136, 136, 136, 136, 136, 136, 136, 136, 216, 117, 52, 67, 83, 20,
+  34, 67, 66, 34, 36, 1, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8,
+  8, 136, 0, 136, 0, 8, 136, 0, 136, 0, 255, 255, 255, 141, 11, 186, 169, 169, 157, 152,
+  208, 169, 192, 234, 205, 138, 136, 136, 136, 232, 33, 50, 51, 51, 17, 32, 128, 179, 200, 192,
+  240, 171, 169, 218, 139, 188, 202, 137, 136, 136, 136, 136, 82, 36, 42, 191, 136, 136, 136, 136,
+  136, 136, 136, 136, 136, 136, 136, 136, 248, 119, 69, 66, 35, 35, 99, 33, 36, 49, 34, 131,
+  128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 8, 128, 8, 128, 8, 128, 8, 128, 8,
+  128, 255, 255, 255, 154, 169, 154, 154, 13, 202, 11, 152, 171, 186, 139, 255, 219, 138, 136, 136,
+  216, 32, 51, 52, 50, 50, 18, 34, 168, 195, 10, 172, 159, 155, 140, 233, 137, 153, 203, 160,
+  153, 136, 200, 81, 35, 4, 138, 218, 201, 137, 136, 136, 136, 136, 136, 136, 136, 136, 136, 94,
+  103, 18, 51, 37, 19, 36, 67, 50, 50, 67, 129, 128, 128, 128, 128, 128, 128, 128, 128, 128,
+  128, 128, 128, 128, 128, 128, 8, 128, 8, 128, 8, 240, 255, 255, 158, 153, 169, 171, 168, 175,
+  176, 139, 160, 171, 159, 137, 169, 138, 186, 203, 59, 203, 172, 179, 8, 216, 184, 208, 179, 195,
+  180, 3, 200, 3, 72, 180, 179, 52, 60, 8, 88, 48, 128, 68, 59, 180, 3, 83, 59, 180,
+  36, 72, 179, 51, 64, 75, 72, 32, 64, 132, 128, 128, 64, 59, 134, 75, 56, 179, 52, 60,
+  75, 162, 195, 131, 128, 182, 67, 59, 128, 60, 48, 75, 60, 139, 180, 48, 12, 195, 180, 72,
+  59, 219, 48, 60, 203, 72, 59, 139, 80, 187, 131, 208, 75, 8, 200, 132, 192, 11, 179, 196,
+  179, 59, 75, 184, 180, 61, 8, 60, 139, 64, 139, 60, 139, 128, 128, 128, 254, 162, 178, 75,
+  184, 48, 75, 60, 11, 195, 180, 72, 59, 139, 0
+};
+const AdpcmAsset fastinvader1Adpcm = {fastinvader1Data, 982, -1536, 75};
+
+const uint8_t fastinvader2Data[521] = {
+  232, 191, 187, 170, 34, 53, 37, 20, 35, 50, 50, 50, 128, 65, 9, 216, 184, 218, 169, 141,
+  186, 156, 140, 185, 171, 156, 156, 10, 134, 19, 1, 200, 201, 249, 169, 139, 136, 136, 136, 136,
+  136, 136, 136, 136, 216, 82, 22, 38, 18, 36, 20, 34, 51, 35, 68, 50, 50, 18, 128, 128,
+  128, 128, 128, 8, 128, 8, 8, 128, 128, 8, 8, 128, 128, 248, 255, 175, 173, 192, 154, 170,
+  171, 187, 236, 25, 156, 168, 10, 14, 12, 154, 10, 13, 10, 138, 170, 184, 200, 184, 248, 157,
+  136, 136, 136, 136, 136, 248, 55, 67, 33, 18, 19, 130, 162, 2, 184, 228, 8, 140, 137, 189,
+  194, 169, 169, 224, 153, 42, 66, 22, 18, 152, 192, 201, 185, 203, 201, 136, 136, 136, 136, 200,
+  1, 23, 67, 65, 35, 53, 18, 51, 38, 34, 51, 36, 131, 128, 128, 128, 128, 128, 128, 128,
+  8, 8, 128, 8, 128, 128, 8, 8, 128, 8, 128, 128, 8, 128, 8, 240, 255, 255, 191, 171,
+  154, 13, 172, 154, 170, 185, 11, 159, 137, 173, 145, 156, 168, 169, 171, 8, 188, 159, 136, 136,
+  136, 136, 136, 136, 127, 67, 50, 19, 33, 3, 130, 179, 184, 200, 188, 187, 173, 159, 169, 192,
+  154, 170, 186, 28, 90, 22, 18, 162, 160, 157, 203, 137, 136, 136, 136, 136, 136, 136, 136, 136,
+  120, 55, 68, 51, 38, 66, 49, 50, 21, 35, 51, 19, 8, 8, 8, 8, 8, 8, 128, 8,
+  128, 8, 8, 128, 8, 128, 8, 128, 8, 128, 8, 128, 8, 248, 255, 255, 175, 155, 154, 186,
+  224, 153, 156, 154, 145, 158, 160, 156, 171, 170, 176, 192, 176, 192, 187, 253, 137, 136, 136, 136,
+  136, 232, 37, 38, 19, 20, 129, 129, 130, 145, 145, 184, 138, 143, 217, 153, 137, 188, 170, 170,
+  171, 60, 75, 23, 19, 128, 162, 173, 201, 203, 153, 136, 136, 136, 136, 136, 136, 136, 110, 21,
+  21, 67, 66, 34, 33, 37, 51, 34, 51, 5, 128, 128, 128, 128, 128, 128, 128, 128, 8, 8,
+  128, 8, 128, 128, 8, 8, 128, 8, 128, 128, 248, 255, 255, 156, 185, 202, 152, 172, 169, 170,
+  142, 192, 160, 12, 169, 138, 10, 159, 137, 169, 176, 11, 203, 179, 139, 180, 8, 216, 8, 104,
+  139, 180, 75, 2, 60, 75, 56, 59, 4, 108, 8, 162, 2, 131, 83, 59, 64, 56, 88, 56,
+  48, 64, 64, 179, 83, 48, 179, 3, 134, 132, 48, 59, 181, 51, 75, 72, 4, 200, 51, 59,
+  60, 64, 48, 12, 195, 132, 11, 3, 180, 195, 3, 60, 192, 195, 3, 12, 195, 67, 59, 172,
+  131, 60, 75, 184, 48, 208, 60, 179, 140, 180, 179, 61, 139, 203, 48, 188, 72, 139, 181, 11,
+  179, 195, 180, 12, 72, 59, 172, 131, 139, 180, 180, 195, 179, 8, 8, 8, 8, 8, 200, 95,
+  60, 11, 200, 195, 48, 192, 195, 42, 192, 48, 59, 76, 139, 64, 59, 60, 139, 181, 128, 8,
+  5
+};
+const AdpcmAsset fastinvader2Adpcm = {fastinvader2Data, 1042, 0, 58};
+
+const uint8_t fastinvader3Data[527] = {
+  116, 241, 195, 254, 187, 171, 25, 114, 34, 36, 19, 36, 18, 3, 18, 8, 8, 152, 11, 159,
+  171, 172, 203, 156, 155, 156, 171, 204, 153, 186, 34, 21, 4, 168, 240, 170, 203, 170, 136, 136,
+  136, 136, 136, 136, 136, 136, 136, 216, 119, 50, 35, 69, 34, 49, 66, 65, 19, 5, 35, 49,
+  8, 8, 8, 8, 8, 8, 8, 136, 128, 0, 136, 0, 8, 136, 128, 0, 136, 255, 255, 217,
+  155, 170, 13, 139, 172, 169, 157, 160, 168, 13, 170, 10, 14, 12, 10, 156, 12, 137, 25, 170,
+  179, 128, 140, 180, 128, 200, 88, 8, 156, 136, 136, 136, 136, 136, 120, 119, 67, 50, 18, 34,
+  65, 56, 1, 42, 138, 216, 168, 216, 200, 171, 160, 216, 202, 160, 172, 32, 68, 51, 32, 171,
+  186, 191, 203, 203, 9, 171, 10, 11, 56, 124, 1, 19, 82, 51, 52, 67, 81, 3, 52, 80,
+  2, 50, 0, 8, 8, 8, 8, 8, 8, 8, 136, 128, 0, 136, 0, 8, 136, 128, 0, 136,
+  0, 8, 136, 0, 255, 255, 255, 153, 169, 192, 154, 201, 185, 160, 170, 157, 170, 170, 171, 200,
+  187, 248, 168, 160, 187, 192, 28, 138, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136,
+  136, 120, 119, 119, 39, 17, 8, 1, 129, 145, 160, 144, 170, 176, 186, 203, 187, 188, 203, 235,
+  152, 8, 69, 83, 0, 144, 186, 173, 203, 185, 155, 136, 136, 136, 136, 136, 56, 103, 50, 68,
+  20, 82, 17, 34, 21, 50, 51, 19, 3, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8,
+  8, 8, 8, 8, 128, 8, 8, 128, 8, 128, 255, 255, 255, 170, 153, 202, 169, 156, 170, 216,
+  9, 157, 137, 201, 10, 170, 171, 11, 188, 192, 139, 11, 141, 42, 143, 128, 176, 128, 138, 194,
+  178, 136, 211, 194, 82, 59, 180, 51, 75, 88, 162, 66, 179, 36, 132, 75, 131, 131, 133, 3,
+  67, 180, 72, 50, 64, 56, 132, 122, 128, 16, 42, 36, 168, 2, 180, 132, 180, 3, 131, 133,
+  128, 181, 3, 131, 192, 195, 83, 59, 59, 128, 182, 128, 128, 181, 195, 3, 12, 195, 179, 140,
+  180, 3, 200, 192, 179, 72, 203, 48, 75, 200, 179, 12, 195, 179, 59, 12, 8, 62, 59, 219,
+  48, 12, 59, 203, 72, 139, 180, 192, 179, 128, 8, 128, 8, 128, 128, 252, 104, 59, 75, 203,
+  48, 60, 187, 3, 140, 180, 72, 203, 3, 60, 59, 12, 8, 61, 59, 76, 59, 179, 132, 139,
+  224, 131, 192, 3, 60, 179, 196, 48, 184, 196, 3, 56, 192, 195, 3, 60, 139, 180, 132, 128,
+  181, 72, 75, 184, 48, 76, 187, 179, 132, 64, 184, 196, 179, 67, 75, 8, 60, 128, 8, 128,
+  8, 128, 112, 75, 184, 72, 192, 67, 192, 179, 67, 203, 51, 203, 3, 72, 11, 3, 61, 192,
+  3, 140, 180, 3, 140, 180, 179, 195, 180, 3, 60, 12, 8, 88, 59, 192, 131, 12, 179, 132,
+  75, 12, 131, 75, 60, 139, 0
+};
+const AdpcmAsset fastinvader3Adpcm = {fastinvader3Data, 1054, 0, 39};
+
+const uint8_t fastinvader4Data[549] = {
+  144, 145, 0, 0, 152, 129, 128, 160, 130, 42, 75, 136, 255, 188, 155, 26, 66, 99, 49, 50,
+  36, 19, 18, 2, 8, 8, 72, 137, 157, 156, 171, 172, 189, 217, 152, 185, 217, 168, 168, 8,
+  83, 147, 33, 172, 174, 187, 172, 137, 136, 136, 136, 136, 136, 136, 136, 136, 136, 124, 55, 84,
+  64, 64, 33, 33, 66, 65, 34, 33, 65, 2, 8, 8, 8, 8, 8, 8, 8, 136, 128, 0,
+  136, 0, 8, 136, 128, 0, 136, 255, 255, 14, 187, 201, 221, 202, 170, 152, 1, 34, 36, 50,
+  49, 33, 81, 8, 162, 186, 176, 251, 152, 218, 233, 168, 186, 185, 203, 137, 136, 136, 136, 136,
+  136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 120, 119,
+  119, 119, 23, 16, 129, 18, 17, 2, 0, 0, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8,
+  8, 8, 8, 8, 8, 8, 8, 8, 8, 128, 248, 255, 255, 255, 138, 128, 16, 16, 33, 33,
+  1, 18, 1, 145, 8, 14, 154, 156, 203, 187, 156, 158, 169, 171, 235, 160, 140, 136, 136, 248,
+  16, 152, 144, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 248, 119,
+  87, 34, 50, 36, 34, 67, 51, 34, 115, 1, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
+  128, 128, 128, 128, 128, 128, 128, 253, 255, 217, 169, 206, 173, 186, 152, 0, 50, 35, 52, 66,
+  35, 18, 32, 42, 11, 236, 169, 202, 188, 192, 171, 189, 186, 172, 186, 139, 136, 136, 136, 136,
+  44, 8, 184, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 120, 119, 119,
+  119, 19, 17, 34, 33, 50, 35, 131, 128, 128, 128, 128, 128, 128, 128, 8, 8, 128, 8, 128,
+  128, 8, 8, 128, 8, 128, 128, 8, 240, 255, 255, 255, 155, 154, 25, 41, 19, 65, 50, 49,
+  133, 17, 40, 200, 153, 156, 186, 172, 203, 232, 170, 154, 173, 169, 187, 137, 136, 136, 136, 29,
+  131, 180, 171, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 136, 119, 119, 119,
+  3, 18, 49, 18, 51, 51, 67, 129, 128, 128, 128, 128, 128, 128, 128, 8, 8, 128, 8, 128,
+  128, 8, 8, 128, 8, 128, 128, 255, 255, 191, 169, 217, 169, 154, 218, 154, 170, 138, 192, 171,
+  203, 187, 188, 128, 188, 184, 216, 172, 192, 48, 188, 180, 42, 58, 12, 8, 72, 128, 76, 72,
+  192, 131, 75, 195, 3, 56, 59, 134, 180, 3, 66, 59, 64, 48, 60, 64, 72, 51, 60, 128,
+  133, 131, 64, 192, 51, 128, 4, 60, 88, 59, 3, 60, 132, 48, 76, 8, 56, 75, 132, 192,
+  51, 192, 179, 196, 179, 3, 8, 180, 195, 48, 12, 216, 3, 60, 128, 61, 128, 12, 60, 60,
+  75, 59, 60, 187, 179, 8, 14, 195, 179, 140, 180, 128, 75, 3, 13, 184, 179, 61, 179, 60,
+  128, 173, 56, 75, 59, 12, 8, 8, 8, 248, 13, 195, 10, 162, 195, 48, 12, 195, 179, 72,
+  203, 67, 11, 195, 179, 72, 75, 203, 6
+};
+const AdpcmAsset fastinvader4Adpcm = {fastinvader4Data, 1098, 1280, 75};
+
+const uint8_t highpitchData[901] = {
+  175, 160, 42, 48, 18, 145, 134, 169, 187, 225, 41, 65, 2, 0, 150, 185, 154, 233, 17, 50,
+  17, 105, 144, 186, 28, 14, 16, 35, 128, 51, 171, 190, 241, 24, 33, 2, 56, 179, 218, 11,
+  143, 17, 50, 128, 5, 169, 187, 249, 16, 34, 2, 97, 153, 187, 208, 30, 32, 1, 48, 160,
+  187, 186, 46, 64, 18, 64, 161, 219, 184, 30, 33, 33, 72, 161, 218, 184, 30, 32, 2, 65,
+  152, 187, 249, 24, 34, 130, 36, 170, 156, 220, 1, 35, 16, 149, 184, 155, 15, 33, 33, 88,
+  152, 170, 218, 40, 34, 131, 6, 169, 156, 140, 34, 34, 97, 152, 171, 251, 16, 34, 48, 151,
+  168, 185, 28, 33, 2, 5, 185, 186, 13, 34, 3, 86, 153, 138, 204, 17, 17, 50, 154, 156,
+  205, 17, 2, 99, 153, 169, 139, 50, 3, 22, 170, 233, 13, 17, 17, 131, 201, 216, 28, 17,
+  33, 163, 170, 222, 16, 17, 50, 153, 172, 220, 33, 1, 3, 201, 217, 28, 17, 65, 152, 170,
+  220, 17, 33, 131, 170, 220, 29, 17, 50, 169, 233, 26, 33, 65, 161, 170, 207, 17, 48, 147,
+  154, 159, 1, 18, 19, 155, 205, 16, 3, 37, 154, 219, 29, 17, 19, 154, 235, 28, 2, 19,
+  154, 204, 16, 34, 84, 138, 204, 1, 49, 147, 170, 207, 17, 49, 164, 200, 28, 16, 67, 153,
+  218, 40, 33, 3, 171, 207, 17, 65, 160, 217, 28, 17, 4, 154, 205, 17, 65, 160, 217, 41,
+  48, 147, 201, 140, 18, 37, 138, 205, 1, 50, 164, 202, 44, 48, 163, 248, 42, 56, 132, 185,
+  12, 33, 21, 170, 205, 2, 20, 138, 157, 2, 36, 154, 205, 2, 20, 154, 156, 18, 21, 170,
+  11, 49, 133, 232, 42, 88, 162, 216, 41, 65, 144, 172, 1, 21, 153, 141, 18, 4, 217, 42,
+  80, 148, 172, 130, 69, 185, 27, 96, 148, 187, 1, 22, 185, 43, 96, 162, 187, 34, 69, 186,
+  42, 51, 209, 140, 65, 163, 188, 18, 20, 203, 41, 36, 217, 43, 65, 176, 12, 65, 161, 156,
+  65, 162, 172, 50, 131, 175, 34, 131, 174, 34, 131, 158, 48, 147, 158, 49, 163, 157, 65, 180,
+  139, 82, 192, 9, 51, 218, 41, 83, 172, 48, 147, 157, 50, 226, 26, 66, 187, 56, 148, 156,
+  66, 209, 42, 66, 173, 34, 212, 25, 50, 158, 33, 243, 41, 34, 174, 35, 209, 74, 145, 154,
+  52, 157, 48, 226, 57, 146, 171, 38, 157, 35, 185, 105, 193, 74, 178, 42, 2, 157, 21, 156,
+  20, 156, 35, 187, 67, 202, 50, 202, 65, 185, 65, 201, 50, 187, 52, 173, 20, 171, 6, 140,
+  132, 43, 194, 73, 193, 72, 185, 19, 156, 150, 59, 193, 88, 185, 4, 11, 180, 89, 185, 133,
+  43, 193, 64, 155, 166, 90, 170, 149, 91, 200, 3, 11, 180, 105, 185, 19, 13, 164, 107, 200,
+  49, 171, 5, 12, 148, 59, 194, 90, 176, 89, 192, 48, 200, 49, 186, 66, 186, 66, 201, 65,
+  201, 64, 192, 89, 192, 73, 177, 41, 130, 156, 22, 157, 20, 170, 64, 226, 57, 146, 156, 37,
+  156, 48, 213, 41, 34, 159, 35, 208, 57, 130, 172, 36, 200, 74, 130, 156, 50, 225, 25, 67,
+  157, 48, 195, 154, 67, 224, 25, 20, 187, 56, 5, 157, 49, 195, 155, 98, 193, 10, 65, 192,
+  26, 50, 232, 25, 50, 232, 25, 50, 232, 9, 50, 225, 10, 66, 193, 154, 82, 164, 156, 50,
+  130, 173, 1, 6, 202, 41, 35, 216, 10, 81, 161, 172, 18, 4, 218, 41, 50, 192, 140, 65,
+  130, 219, 40, 50, 184, 158, 34, 3, 235, 44, 80, 160, 156, 1, 21, 154, 13, 33, 132, 217,
+  41, 104, 144, 217, 40, 65, 160, 187, 17, 37, 152, 159, 130, 21, 137, 206, 130, 68, 137, 157,
+  2, 51, 153, 159, 1, 51, 176, 204, 32, 97, 160, 232, 44, 48, 146, 233, 26, 17, 69, 138,
+  141, 2, 66, 168, 218, 44, 48, 146, 201, 12, 18, 84, 137, 204, 16, 65, 145, 185, 12, 18,
+  36, 184, 250, 40, 17, 132, 138, 158, 2, 65, 161, 185, 14, 33, 81, 168, 216, 41, 16, 35,
+  169, 220, 40, 17, 21, 154, 234, 40, 1, 20, 154, 234, 40, 1, 68, 153, 217, 40, 16, 35,
+  185, 250, 28, 32, 49, 168, 202, 14, 17, 49, 150, 153, 204, 17, 1, 133, 153, 202, 40, 33,
+  81, 153, 170, 14, 33, 32, 148, 154, 251, 16, 17, 65, 153, 170, 14, 17, 2, 133, 154, 217,
+  28, 32, 48, 149, 153, 187, 33, 34, 114, 153, 169, 141, 17, 18, 99, 153, 154, 15, 17, 1,
+  99, 153, 153, 13, 17, 1, 99, 153, 137, 13, 1, 2, 50, 170, 186, 207, 17, 2, 80, 137,
+  154, 202, 17, 19, 65, 178, 186, 220, 24, 66, 129, 135, 153, 138, 14, 1, 18, 88, 137, 170,
+  248, 16, 17, 129, 149, 168, 153, 15, 1, 18, 72, 152, 185, 232, 24, 49, 1, 66, 154, 157,
+  217, 17, 49, 0, 134, 169, 154, 156, 18, 51, 17, 151, 169, 155, 14, 17, 19, 17, 150, 185,
+  154, 15, 1, 35, 24, 151, 168, 138, 234, 17, 2, 129, 133, 153, 155, 233, 17, 49, 0, 97,
+  10
+};
+const AdpcmAsset highpitchAdpcm = {highpitchData, 1802, 32512, 78};
+
+#endif
@@ -2,6 +2,8 @@
 // Sound assets based off the original Space Invaders
 // Jonathan Valvano
 // 11/15/2021 
+// 8-bit samples at 11.025kHz from WC.m. The firmware doesn't include
+// this, tools/adpcm encodes it into adpcm.h
 #ifndef __SOUND_H
 #define __SOUND_H
 #include <stdint.h>
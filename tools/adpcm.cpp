@@ -0,0 +1,180 @@
+// adpcm.cpp
+// Runs on Linux (host tool, not part of the firmware build)
+// Encodes the 8-bit sound arrays of a header like sounds/sounds.h as
+// 4-bit IMA-ADPCM for Sound.cpp, see Adpcm.h
+//
+// usage: adpcm sounds.h > adpcm.h
+//
+// Every "uint8_t name[N] = { ... };" array becomes a nameData nibble
+// array and a nameAdpcm asset; // comments inside an array are skipped,
+// as in explosion. Each nibble is the code that leaves the least error
+// over its sample and the best next one, which follows the sharp edges
+// of these sounds better than the closest code alone. Each asset starts
+// from the step index that gives it the least error overall. The header goes to stdout, the flash and
+// signal-to-noise report goes to stderr.
+//
+// Then: make -C tools && tools/adpcm sounds/sounds.h > sounds/adpcm.h
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <string>
+#include <vector>
+#include "../Adpcm.h"
+
+struct Asset {
+    std::string name;
+    std::vector<uint8_t> samples;
+};
+
+struct Encoded {
+    std::vector<uint8_t> codes;     // one nibble each
+    int16_t predictor;
+    uint8_t index;
+    double error;                   // sum of squares, 8-bit steps
+};
+
+static void fail(const char *msg){
+    fprintf(stderr, "adpcm: %s\n", msg);
+    exit(1);
+}
+
+// The arrays in a C header, comments left out
+static std::vector<Asset> parse(const std::string &text){
+    std::vector<Asset> assets;
+    size_t pos = 0;
+    while((pos = text.find("uint8_t", pos)) != std::string::npos){
+        pos += 7;
+        size_t open = text.find('[', pos);
+        size_t brace = text.find('{', pos);
+        size_t semi = text.find(';', pos);
+        if(open == std::string::npos || brace == std::string::npos || brace > semi){
+            continue;
+        }
+        Asset a;
+        size_t start = text.find_first_not_of(" \t", pos);
+        a.name = text.substr(start, open - start);
+        size_t i = brace + 1;
+        while(i < text.size() && text[i] != '}'){
+            if(text.compare(i, 2, "//") == 0){
+                i = text.find('\n', i);
+            }
+            else if(text[i] >= '0' && text[i] <= '9'){
+                char *end;
+                long v = strtol(&text[i], &end, 10);
+                if(v > 255){
+                    fail("sample over 255");
+                }
+                a.samples.push_back((uint8_t)v);
+                i = end - &text[0];
+            }
+            else{
+                i++;
+            }
+        }
+        if(a.samples.size() < 2){
+            fail("array with under 2 samples");
+        }
+        assets.push_back(a);
+        pos = i;
+    }
+    return assets;
+}
+
+static Encoded encode(const std::vector<uint8_t> &samples, uint8_t index){
+    Encoded e;
+    e.predictor = (int16_t)((samples[0] - 128)<<8);
+    e.index = index;
+    e.error = 0;
+    Adpcm s = {0, 0, e.predictor, index};
+    for(size_t i = 1; i < samples.size(); i++){
+        int32_t target = (samples[i] - 128)<<8;
+        bool last = (i + 1 == samples.size());
+        int32_t next = last ? 0 : (samples[i+1] - 128)<<8;
+        uint32_t best = 0;
+        int64_t bestError = INT64_MAX;
+        for(uint32_t code = 0; code < 16; code++){
+            Adpcm trial = s;
+            int64_t d = Adpcm_Apply(&trial, code) - target;
+            int64_t error = d*d, ahead = last ? 0 : INT64_MAX;
+            for(uint32_t code2 = 0; !last && code2 < 16; code2++){
+                Adpcm trial2 = trial;
+                int64_t d2 = Adpcm_Apply(&trial2, code2) - next;
+                if(d2*d2 < ahead){
+                    ahead = d2*d2;
+                }
+            }
+            if(error + ahead < bestError){
+                bestError = error + ahead;
+                best = code;
+            }
+        }
+        Adpcm_Apply(&s, best);
+        e.codes.push_back(best);
+        double d = (s.predictor>>8) - (samples[i] - 128);
+        e.error += d*d;
+    }
+    return e;
+}
+
+int main(int argc, char **argv){
+    if(argc != 2){
+        fprintf(stderr, "usage: adpcm sounds.h > adpcm.h\n");
+        return 2;
+    }
+    FILE *f = fopen(argv[1], "rb");
+    if(f == 0)
+        fail("can't open input");
+    std::string text;
+    char buf[4096];
+    size_t n;
+    while((n = fread(buf, 1, sizeof(buf), f)) > 0){
+        text.append(buf, n);
+    }
+    fclose(f);
+    std::vector<Asset> assets = parse(text);
+    if(assets.empty())
+        fail("no uint8_t arrays");
+
+    printf("// adpcm.h\n");
+    printf("// 4-bit IMA-ADPCM sound assets, made from sounds.h by tools/adpcm, don't edit\n");
+    printf("// See Adpcm.h for the format\n");
+    printf("#ifndef SOUNDS_ADPCM_H\n#define SOUNDS_ADPCM_H\n");
+    printf("#include <stdint.h>\n#include \"../Adpcm.h\"\n");
+    size_t raw = 0, packed = 0;
+    for(const Asset &a : assets){
+        Encoded best;
+        best.error = -1;
+        for(int index = 0; index < ADPCM_STEPS; index++){
+            Encoded e = encode(a.samples, index);
+            if(best.error < 0 || e.error < best.error){
+                best = e;
+            }
+        }
+        size_t bytes = (best.codes.size() + 1)/2;
+        printf("\nconst uint8_t %sData[%zu] = {", a.name.c_str(), bytes);
+        for(size_t i = 0; i < bytes; i++){
+            uint8_t lo = best.codes[2*i];
+            uint8_t hi = (2*i + 1 < best.codes.size()) ? best.codes[2*i + 1] : 0;
+            printf("%s%s%u", i ? "," : "", (i%20) ? " " : "\n  ", (unsigned)(lo | hi<<4));
+        }
+        printf("\n};\n");
+        printf("const AdpcmAsset %sAdpcm = {%sData, %zu, %d, %u};\n", a.name.c_str(),
+               a.name.c_str(), a.samples.size(), best.predictor, best.index);
+
+        double signal = 0;
+        for(uint8_t s : a.samples){
+            signal += (s - 128.0)*(s - 128.0);
+        }
+        double snr = best.error > 0 ? 10*log10(signal/best.error) : 99;
+        fprintf(stderr, "%-14s %5zu samples %5zu bytes, %4.1f dB SNR\n", a.name.c_str(),
+                a.samples.size(), bytes + 12, snr);     // 12 bytes of AdpcmAsset
+        raw += a.samples.size();
+        packed += bytes + 12;
+    }
+    printf("\n#endif\n");
+    fprintf(stderr, "%zu bytes of 8-bit samples in %zu bytes, %zu%%\n", raw, packed, packed*100/raw);
+    return 0;
+}
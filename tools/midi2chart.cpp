@@ -0,0 +1,427 @@
+// midi2chart.cpp
+// Runs on Linux (host tool, not part of the firmware build)
+// Turns a standard MIDI file into a song chart for Charts.cpp
+//
+// usage: midi2chart [options] song.mid > Song.h
+//   -n name    array name, default taken from the file name
+//   -t track   only use this track, default merges every track
+//   -r ms      row period in ms, default 500 (30 pixel rows, 2 pixels a frame at 30Hz)
+//   -l rows    lead-in rows before the first note, default 3
+//   -c         allow two-key chords when the MIDI has them
+//   -H         notes longer than a row become hold notes, otherwise every note is a tap
+//
+// The melody is the highest note starting in each row. Notes are
+// quantized to the row grid, transposed by octaves into the pitch range
+// the firmware plays, and given lanes that follow the melody's contour.
+// Each note stores its length and the gap to the next one in rows, so
+// the chart is delta timed; a rest too long for one note goes on in
+// spacer notes with no keys. The header goes to stdout, the density and
+// flash report goes to stderr; flash is the packed size from Chart.h.
+//
+// Then include the header from Charts.cpp and add a CHART() entry to Charts[].
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "../Chart.h"
+
+#define CHART_ENTRY_BYTES 20    // sizeof(Chart) on the Cortex-M0+
+
+struct MidiNote {
+    uint32_t on;        // ticks
+    uint32_t off;
+    uint8_t pitch;
+};
+
+struct TempoChange {
+    uint32_t tick;
+    uint32_t usPerBeat;
+};
+
+struct OutNote {
+    uint32_t row;       // row the note starts on, lead-in not included
+    uint32_t endRow;
+    uint8_t pitch;
+    uint8_t chord;      // notes starting in the same row
+    uint8_t lanes;
+};
+
+static void fail(const char *msg){
+    fprintf(stderr, "midi2chart: %s\n", msg);
+    exit(1);
+}
+
+static uint32_t be32(const uint8_t *p){
+    return ((uint32_t)p[0]<<24)|((uint32_t)p[1]<<16)|((uint32_t)p[2]<<8)|p[3];
+}
+
+static uint16_t be16(const uint8_t *p){
+    return (uint16_t)((p[0]<<8)|p[1]);
+}
+
+// Variable length quantity, up to 4 bytes
+static uint32_t readVlq(const uint8_t *&p, const uint8_t *end){
+    uint32_t v = 0;
+    for(int i = 0; i < 4; i++){
+        if(p >= end)
+            fail("truncated track");
+        uint8_t b = *p++;
+        v = (v<<7)|(b&0x7F);
+        if((b&0x80) == 0)
+            return v;
+    }
+    fail("bad variable length value");
+    return 0;
+}
+
+// Collects the notes and tempo changes of one MTrk chunk
+static void readTrack(const uint8_t *p, const uint8_t *end,
+                      std::vector<MidiNote> &notes, std::vector<TempoChange> &tempos){
+    uint32_t tick = 0;
+    uint8_t status = 0;
+    int32_t onTick[16][128];
+    for(int c = 0; c < 16; c++){
+        for(int k = 0; k < 128; k++){
+            onTick[c][k] = -1;
+        }
+    }
+
+    while(p < end){
+        tick += readVlq(p, end);
+        if(p >= end)
+            fail("truncated track");
+        uint8_t b = *p;
+        if(b & 0x80){
+            status = b;
+            p++;
+        }
+        else if(status == 0){
+            fail("running status with no status byte");
+        }
+
+        if(status == 0xFF){                 // meta event
+            if(p >= end)
+                fail("truncated meta event");
+            uint8_t type = *p++;
+            uint32_t len = readVlq(p, end);
+            if(p + len > end)
+                fail("truncated meta event");
+            if(type == 0x51 && len == 3){
+                TempoChange t = {tick, ((uint32_t)p[0]<<16)|((uint32_t)p[1]<<8)|p[2]};
+                tempos.push_back(t);
+            }
+            p += len;
+            if(type == 0x2F)
+                break;
+            status = 0;                     // meta and sysex cancel running status
+        }
+        else if(status == 0xF0 || status == 0xF7){   // sysex
+            uint32_t len = readVlq(p, end);
+            p += len;
+            status = 0;
+        }
+        else{
+            uint8_t type = status & 0xF0;
+            uint8_t chan = status & 0x0F;
+            uint32_t n = (type == 0xC0 || type == 0xD0) ? 1 : 2;
+            if(p + n > end)
+                fail("truncated channel event");
+            if(chan != 9 && (type == 0x80 || type == 0x90)){   // channel 10 is drums
+                uint8_t key = p[0] & 0x7F;
+                bool on = (type == 0x90) && (p[1] != 0);
+                if(onTick[chan][key] >= 0){  // any event on a sounding key ends it
+                    MidiNote m = {(uint32_t)onTick[chan][key], tick, key};
+                    notes.push_back(m);
+                    onTick[chan][key] = -1;
+                }
+                if(on){
+                    onTick[chan][key] = tick;
+                }
+            }
+            p += n;
+        }
+    }
+}
+
+// Converts a tick to milliseconds through the tempo map
+static double tickToMs(uint32_t tick, const std::vector<TempoChange> &tempos, uint16_t division){
+    double ms = 0;
+    uint32_t lastTick = 0;
+    uint32_t usPerBeat = 500000;            // 120 BPM until told otherwise
+    for(size_t i = 0; i < tempos.size() && tempos[i].tick <= tick; i++){
+        ms += (double)(tempos[i].tick - lastTick)*usPerBeat/division/1000.0;
+        lastTick = tempos[i].tick;
+        usPerBeat = tempos[i].usPerBeat;
+    }
+    return ms + (double)(tick - lastTick)*usPerBeat/division/1000.0;
+}
+
+static uint8_t fitPitch(int pitch){
+    while(pitch < CHART_PITCH_LOW){
+        pitch += 12;
+    }
+    while(pitch > CHART_PITCH_HIGH){
+        pitch -= 12;
+    }
+    return (uint8_t)pitch;
+}
+
+// Lane 0 is Key1 on the left, bit 3 of the mask
+static uint8_t laneBit(int lane){
+    return (uint8_t)(1<<(3 - lane));
+}
+
+// Lanes follow the melody: up moves right, down moves left, a repeat stays
+static void assignLanes(std::vector<OutNote> &out, bool chords){
+    int lane = 0;
+    for(size_t i = 0; i < out.size(); i++){
+        if(i > 0){
+            int step = (int)out[i].pitch - (int)out[i-1].pitch;
+            if(step > 0){
+                lane += (step > 4) ? 2 : 1;
+            }
+            else if(step < 0){
+                lane -= (step < -4) ? 2 : 1;
+            }
+            if(lane > 3){
+                lane = (step > 4) ? 3 : 2;  // bounce off the edge rather than stick to it
+            }
+            if(lane < 0){
+                lane = (step < -4) ? 0 : 1;
+            }
+        }
+        out[i].lanes = laneBit(lane);
+        if(chords && out[i].chord > 1){
+            out[i].lanes |= laneBit(lane < 2 ? lane + 2 : lane - 2);
+        }
+    }
+}
+
+static std::string baseName(const char *path){
+    std::string s = path;
+    size_t slash = s.find_last_of('/');
+    if(slash != std::string::npos){
+        s = s.substr(slash + 1);
+    }
+    size_t dot = s.find_last_of('.');
+    if(dot != std::string::npos){
+        s = s.substr(0, dot);
+    }
+    std::string name;
+    bool upper = true;
+    for(size_t i = 0; i < s.size(); i++){
+        char c = s[i];
+        if((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9')){
+            name += upper && c >= 'a' && c <= 'z' ? (char)(c - 'a' + 'A') : c;
+            upper = false;
+        }
+        else{
+            upper = true;
+        }
+    }
+    if(name.empty() || (name[0] >= '0' && name[0] <= '9')){
+        name = "Song" + name;
+    }
+    return name;
+}
+
+static const char *NoteNames[12] = {"C", "Db", "D", "Eb", "E", "F", "Gb", "G", "Ab", "A", "Bb", "B"};
+
+int main(int argc, char **argv){
+    const char *path = 0;
+    std::string name;
+    int track = -1;
+    double rowMs = 500;
+    int leadIn = 3;
+    bool chords = false;
+    bool holds = false;
+
+    for(int i = 1; i < argc; i++){
+        if(strcmp(argv[i], "-n") == 0 && i + 1 < argc){
+            name = argv[++i];
+        }
+        else if(strcmp(argv[i], "-t") == 0 && i + 1 < argc){
+            track = atoi(argv[++i]);
+        }
+        else if(strcmp(argv[i], "-r") == 0 && i + 1 < argc){
+            rowMs = atof(argv[++i]);
+        }
+        else if(strcmp(argv[i], "-l") == 0 && i + 1 < argc){
+            leadIn = atoi(argv[++i]);
+        }
+        else if(strcmp(argv[i], "-c") == 0){
+            chords = true;
+        }
+        else if(strcmp(argv[i], "-H") == 0){
+            holds = true;
+        }
+        else if(argv[i][0] != '-' && path == 0){
+            path = argv[i];
+        }
+        else{
+            fprintf(stderr, "usage: midi2chart [-n name] [-t track] [-r rowms] [-l leadin] [-c] [-H] song.mid\n");
+            return 2;
+        }
+    }
+    if(path == 0){
+        fprintf(stderr, "usage: midi2chart [-n name] [-t track] [-r rowms] [-l leadin] [-c] [-H] song.mid\n");
+        return 2;
+    }
+    if(rowMs <= 0 || leadIn < 0 || leadIn > 255)
+        fail("bad -r or -l value");
+    if(name.empty()){
+        name = baseName(path);
+    }
+
+    FILE *f = fopen(path, "rb");
+    if(f == 0)
+        fail("can't open input");
+    std::vector<uint8_t> data;
+    uint8_t buf[4096];
+    size_t n;
+    while((n = fread(buf, 1, sizeof(buf), f)) > 0){
+        data.insert(data.end(), buf, buf + n);
+    }
+    fclose(f);
+
+    if(data.size() < 14 || memcmp(&data[0], "MThd", 4) != 0)
+        fail("not a MIDI file");
+    uint32_t headerLen = be32(&data[4]);
+    uint16_t tracks = be16(&data[10]);
+    uint16_t division = be16(&data[12]);
+    if(division & 0x8000)
+        fail("SMPTE time division is not supported");
+
+    std::vector<MidiNote> notes;
+    std::vector<TempoChange> tempos;
+    size_t pos = 8 + headerLen;
+    for(int t = 0; t < tracks && pos + 8 <= data.size(); t++){
+        uint32_t len = be32(&data[pos + 4]);
+        if(pos + 8 + len > data.size())
+            fail("truncated chunk");
+        const uint8_t *p = &data[pos + 8];
+        if(memcmp(&data[pos], "MTrk", 4) == 0){
+            std::vector<MidiNote> trackNotes;
+            readTrack(p, p + len, trackNotes, tempos);    // tempo is global, read it from every track
+            if(track < 0 || track == t){
+                notes.insert(notes.end(), trackNotes.begin(), trackNotes.end());
+            }
+        }
+        else{
+            t--;                            // unknown chunks are skipped and don't count
+        }
+        pos += 8 + len;
+    }
+    if(notes.empty())
+        fail("no notes found");
+    std::stable_sort(tempos.begin(), tempos.end(),
+                     [](const TempoChange &a, const TempoChange &b){ return a.tick < b.tick; });
+
+    // Quantize to rows, highest note in a row is the melody
+    std::vector<OutNote> out;
+    uint32_t firstTick = notes[0].on;
+    for(size_t i = 0; i < notes.size(); i++){
+        firstTick = std::min(firstTick, notes[i].on);
+    }
+    double startMs = tickToMs(firstTick, tempos, division);
+    for(size_t i = 0; i < notes.size(); i++){
+        OutNote o;
+        o.row = (uint32_t)((tickToMs(notes[i].on, tempos, division) - startMs)/rowMs + 0.5);
+        o.endRow = (uint32_t)((tickToMs(notes[i].off, tempos, division) - startMs)/rowMs + 0.5);
+        o.pitch = notes[i].pitch;
+        o.chord = 1;
+        o.lanes = 0;
+        out.push_back(o);
+    }
+    std::stable_sort(out.begin(), out.end(), [](const OutNote &a, const OutNote &b){
+        return a.row != b.row ? a.row < b.row : a.pitch > b.pitch;
+    });
+    std::vector<OutNote> melody;
+    for(size_t i = 0; i < out.size(); i++){
+        if(!melody.empty() && melody.back().row == out[i].row){
+            melody.back().chord++;
+            continue;
+        }
+        melody.push_back(out[i]);
+    }
+    for(size_t i = 0; i < melody.size(); i++){
+        melody[i].pitch = fitPitch(melody[i].pitch);
+    }
+    assignLanes(melody, chords);
+
+    // Lengths and rests in rows; a rest over 255 goes on in spacers
+    std::vector<ChartNote> chart;
+    uint32_t span = leadIn;                 // rows of time, a hold takes its length
+    for(size_t i = 0; i < melody.size(); i++){
+        uint32_t len = melody[i].endRow > melody[i].row ? melody[i].endRow - melody[i].row : 1;
+        if(!holds){
+            len = 1;
+        }
+        len = std::min<uint32_t>(len, 255);
+        uint32_t gap;
+        if(i + 1 < melody.size()){
+            gap = melody[i+1].row - melody[i].row;
+            len = std::min(len, gap);
+        }
+        else{
+            gap = len + 1;                  // one empty row so the last note can scroll off
+        }
+        uint32_t rest = gap - len;
+        ChartNote c = {melody[i].pitch, melody[i].lanes, (uint8_t)len, (uint8_t)std::min<uint32_t>(rest, 255)};
+        chart.push_back(c);
+        rest -= c.rest;
+        while(rest > 0){
+            ChartNote spacer = {0, 0, 1, (uint8_t)std::min<uint32_t>(rest - 1, 255)};
+            chart.push_back(spacer);
+            rest -= 1 + spacer.rest;
+        }
+        span += gap;
+    }
+    if(chart.size() > 0xFFFF)
+        fail("song has more than 65535 notes and spacers");
+    uint32_t rows = Chart_CountRows(&chart[0], (uint16_t)chart.size(), (uint8_t)leadIn);
+    if(rows > 0xFFFF)
+        fail("song is longer than 65535 rows");
+    uint32_t spacers = chart.size() - melody.size();
+
+    uint32_t packed = Chart_PackedBytes(&chart[0], (uint16_t)chart.size());
+
+    printf("// %s.h\n", name.c_str());
+    const char *file = strrchr(path, '/') ? strrchr(path, '/') + 1 : path;
+    printf("// Chart generated by tools/midi2chart from %s\n", file);
+    printf("// %u notes, %u rows, included from Charts.cpp\n\n", (unsigned)melody.size(), (unsigned)rows);
+    printf("constexpr ChartNote %s[] = {\n", name.c_str());
+    for(size_t i = 0; i < chart.size(); i++){
+        if(i % 6 == 0){
+            printf("    ");
+        }
+        printf("{%u, %u, %u, %u},", chart[i].pitch, chart[i].lanes, chart[i].duration, chart[i].rest);
+        printf((i % 6 == 5 || i + 1 == chart.size()) ? "\n" : " ");
+    }
+    printf("};\n");
+    printf("CHART_PACK(%s, %d);\n", name.c_str(), leadIn);
+
+    double seconds = span*rowMs/1000.0;
+    uint32_t low = 255, high = 0;
+    for(size_t i = 0; i < melody.size(); i++){
+        low = std::min<uint32_t>(low, melody[i].pitch);
+        high = std::max<uint32_t>(high, melody[i].pitch);
+    }
+    fprintf(stderr, "%s: %u notes, %u rows, %.1f s\n", name.c_str(), (unsigned)melody.size(), (unsigned)rows, seconds);
+    fprintf(stderr, "  density %.2f notes/s, %.2f notes/row\n", melody.size()/seconds, (double)melody.size()/span);
+    fprintf(stderr, "  pitch %s%u..%s%u\n", NoteNames[low%12], low/12 - 1, NoteNames[high%12], high/12 - 1);
+    fprintf(stderr, "  flash %u bytes, %u packed (%.2f a note, %u unpacked) + %u for the Charts[] entry\n",
+            (unsigned)(packed + CHART_ENTRY_BYTES), (unsigned)packed, (double)packed/melody.size(),
+            (unsigned)(chart.size()*sizeof(ChartNote)), CHART_ENTRY_BYTES);
+    if(out.size() > melody.size()){
+        fprintf(stderr, "  %u notes under the melody dropped\n", (unsigned)(out.size() - melody.size()));
+    }
+    if(spacers){
+        fprintf(stderr, "  %u spacers for rests over 255 rows\n", (unsigned)spacers);
+    }
+    return 0;
+}